@@ -0,0 +1,543 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS, EXIT_FAILURE, and strtod
+#include <cstring> // For strcmp and memcmp
+#include <cmath> // For exp, sin, and cos
+#include <cstdint> // For uint64_t
+#include <chrono> // For steady_clock
+#include <condition_variable> // For std::condition_variable
+#include <deque> // For std::deque
+#include <fstream> // For ifstream and ofstream
+#include <iostream> // For cin, cout, cerr, and endl
+#include <limits> // For std::numeric_limits
+#include <map> // For std::map
+#include <memory> // For std::unique_ptr
+#include <mutex> // For std::mutex
+#include <string> // For std::string
+#include <thread> // For std::thread
+#include <vector> // For std::vector
+
+// The library
+#include <hi-solve.h>
+
+/// A queue holding at most a fixed number of items (push blocks while the queue is full, and pop blocks while it is empty)
+
+template<class T>
+class BoundedQueue {
+  private:
+    std::mutex              mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T>           items_;
+    size_t                  capacity_;
+    bool                    closed_;
+
+  public:
+  BoundedQueue(const size_t capacity) : capacity_(capacity), closed_(false) {}
+
+  /// Add an item (blocks while the queue is full)
+  void push(T item){
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this]{ return items_.size() < capacity_; });
+    items_.push_back(std::move(item));
+    notEmpty_.notify_one();
+  }
+
+  /// Remove an item (blocks while the queue is empty, and returns false once the queue is empty and closed)
+  bool pop(T &item){
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this]{ return !items_.empty() || closed_; });
+    if(items_.empty()){ return false; }
+    item = std::move(items_.front());
+    items_.pop_front();
+    notFull_.notify_one();
+    return true;
+  }
+
+  /// Signal that no more items will be added
+  void close(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notEmpty_.notify_all();
+  }
+};
+
+/// The result of solving one problem
+
+struct Row {
+  double      x;            // Approximate solution
+  double      f;            // Function value at the approximate solution
+  size_t      iterations;   // Number of iterations
+  size_t      evaluations;  // Number of function evaluations
+  int         status;       // SolveStatus, or -1 if the row could not be parsed
+};
+
+/// A chunk of consecutive problems (the buffers are reused, i.e. no memory is allocated once the chunks have been filled once)
+
+struct Chunk {
+  size_t              seq = 0;  // Sequence number (used for writing the chunks in the order of the input)
+  size_t              first = 0; // Index of the first problem
+  std::vector<double> values;   // The values of all rows (the initial guess followed by the parameters)
+  std::vector<size_t> offsets;  // Offsets of the rows in values (one more than the number of rows)
+  std::vector<Row>    results;  // Results (one per row)
+
+  size_t size() const { return offsets.size() - 1; }
+  void clear(){ values.clear(); offsets.assign(1, 0); results.clear(); }
+};
+
+/// Polynomial a[0] + a[1]*x + ... + a[m]*x^m with coefficients referring to a row (i.e. without copying them)
+
+class RowPoly : public Fun {
+  private:
+    const double  *a_;
+    size_t        m_;
+
+  public:
+  RowPoly(const double *a, const size_t m) : a_(a), m_(m) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    // Repeated synthetic division (the extended Horner scheme)
+    const size_t Nm = std::min(N, m_);
+    df[0] = a_[m_];
+    for(size_t k = 1; k != N+1; ++k){ df[k] = 0.0; }
+    for(size_t i = m_; i-- != 0;){
+      for(size_t k = std::min(Nm, m_-i); k != 0; --k){ df[k] = df[k]*x + df[k-1]; }
+      df[0] = df[0]*x + a_[i];
+    } // End for i
+
+    // Convert to derivatives
+    double fac = 1.0;
+    for(size_t k = 2; k <= Nm; ++k){
+      fac   *= k;
+      df[k] *= fac;
+    } // End for k
+  }
+};
+
+/// exp(a*x) - b
+
+class RowExp : public Fun {
+  private:
+    double a_, b_;
+
+  public:
+  RowExp(const double a, const double b) : a_(a), b_(b) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    const double e = exp(a_*x);
+    double ak = 1.0;
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = ak*e;
+      ak   *= a_;
+    } // End for k
+    df[0] -= b_;
+  }
+};
+
+/// Kepler's equation, E - e*sin(E) - M
+
+class RowKepler : public Fun {
+  private:
+    double e_, M_;
+
+  public:
+  RowKepler(const double e, const double M) : e_(e), M_(M) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    const double s = sin(x);
+    const double c = cos(x);
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = k%2 == 0 ? s : c;
+      if(k%4 > 1){ df[k] *= -1.0; }
+      df[k] *= -e_;
+    } // End for k
+    df[0] += x - M_;
+    if(N > 0){ df[1] += 1.0; }
+  }
+};
+
+/// Built-in families of functions
+
+enum Family { FamilyPoly, FamilyExp, FamilyKepler };
+
+/// Options given on the command line
+
+struct Options {
+  std::string input;                // Input file (stdin if empty)
+  std::string output;               // Output file (stdout if empty)
+  std::string convert;              // Convert the CSV input to the binary format instead of solving
+  bool        binary      = false;  // Whether or not the input is in the binary format
+  Family      family      = FamilyPoly;
+  double      tol         = 1.0e-12;
+  size_t      maxit       = 50;
+  size_t      Nmax        = 4;
+  size_t      strategy    = 3;
+  bool        safeguarded = false;
+  size_t      threads     = 0;      // Number of solver threads (0 for the number of hardware threads)
+  size_t      chunk       = 1024;   // Number of problems in a chunk
+  size_t      queue       = 4;      // Capacity of the queues (in chunks)
+  bool        progress    = false;  // Whether or not to report the throughput every second
+  bool        help        = false;  // Whether or not to print the usage and exit
+};
+
+/// Names of the statuses (written to the output)
+
+const char *statusName(const int status){
+  switch(status){
+    case SolveConverged:      return "converged";
+    case SolveMaxIterations:  return "max-iterations";
+    case SolveNonFinite:      return "non-finite";
+    case SolveZeroDerivative: return "zero-derivative";
+    case SolveDiverged:       return "diverged";
+    case SolveStagnated:      return "stagnated";
+    case SolveNoSignChange:   return "no-sign-change";
+    default:                  return "invalid";
+  } // End switch status
+}
+
+/// Number of parameters (following the initial guess) of the built-in families (0 for any number)
+
+size_t numParameters(const Family family){ return family == FamilyPoly ? 0 : 2; }
+
+/// Reader of problems in CSV format (one problem per line: the initial guess followed by the parameters, and lines which are empty or start with # are skipped)
+
+class CsvReader {
+  private:
+    std::istream  &in_;
+    std::string   line_;
+
+  public:
+  CsvReader(std::istream &in) : in_(in) {}
+
+  /// Read the next row into the chunk (returns false at the end of the input)
+  bool read(Chunk &chunk){
+    while(std::getline(in_, line_)){
+      if(line_.empty() || line_[0] == '#' || line_.find_first_not_of(" \t\r") == std::string::npos){ continue; }
+
+      // Parse the values (a row which cannot be parsed is stored without values)
+      const size_t offset = chunk.values.size();
+      const char *p = line_.c_str();
+      while(true){
+        char *end;
+        const double v = strtod(p, &end);
+        if(end == p){ chunk.values.resize(offset); break; }
+        chunk.values.push_back(v);
+        while(*end == ' ' || *end == '\t' || *end == '\r'){ ++end; }
+        if(*end == '\0'){ break; }
+        if(*end != ','){ chunk.values.resize(offset); break; }
+        p = end + 1;
+      } // End while true
+      chunk.offsets.push_back(chunk.values.size());
+      return true;
+    } // End while getline
+    return false;
+  }
+};
+
+/// Reader of problems in the columnar binary format
+/**
+The format consists of native-endian 64-bit words: the magic number "HSCOLS01" (8 characters) and the number of columns, c (uint64), followed by any number of blocks. Each block consists of the number of rows, r (uint64), followed by the c columns, each of which holds r values (double). The first column holds the initial guesses and the remaining columns hold the parameters. Only one block is held in memory at a time.
+*/
+
+class BinaryReader {
+  private:
+    std::istream        &in_;
+    uint64_t            cols_;
+    std::vector<double> block_;   // The current block (column-major)
+    uint64_t            rows_;    // Number of rows in the current block
+    uint64_t            next_;    // Next row in the current block
+
+  public:
+  BinaryReader(std::istream &in) : in_(in), cols_(0), rows_(0), next_(0) {
+    char magic[8];
+    if(!in_.read(magic, 8) || std::memcmp(magic, "HSCOLS01", 8) != 0 || !in_.read(reinterpret_cast<char*>(&cols_), 8) || cols_ == 0){
+      throw "The input is not in the columnar binary format.";
+    } // End if not valid
+  }
+
+  /// Read the next row into the chunk (returns false at the end of the input)
+  bool read(Chunk &chunk){
+    // Read the next block
+    while(next_ == rows_){
+      if(!in_.read(reinterpret_cast<char*>(&rows_), 8)){ return false; }
+      block_.resize(rows_*cols_);
+      if(!in_.read(reinterpret_cast<char*>(block_.data()), 8*block_.size())){
+        throw "The input ended in the middle of a block.";
+      } // End if not read
+      next_ = 0;
+    } // End while next_ == rows_
+
+    for(uint64_t j = 0; j != cols_; ++j){
+      chunk.values.push_back(block_[j*rows_ + next_]);
+    } // End for j
+    chunk.offsets.push_back(chunk.values.size());
+    ++next_;
+    return true;
+  }
+
+  /// Write a block in the columnar binary format (the header is written before the first block)
+  static void write(std::ostream &out, const std::vector<std::vector<double> > &rows, const bool header){
+    const uint64_t c = rows.empty() ? 0 : rows[0].size();
+    const uint64_t r = rows.size();
+    if(header){
+      out.write("HSCOLS01", 8);
+      out.write(reinterpret_cast<const char*>(&c), 8);
+    } // End if header
+    out.write(reinterpret_cast<const char*>(&r), 8);
+    for(uint64_t j = 0; j != c; ++j){
+      for(uint64_t i = 0; i != r; ++i){
+        out.write(reinterpret_cast<const char*>(&rows[i][j]), 8);
+      } // End for i
+    } // End for j
+  }
+};
+
+/// Solve the problems in a chunk
+
+void solveChunk(const HiSolve &solver, const Options &opt, HiSolveWorkspace &ws, Chunk &chunk){
+  chunk.results.resize(chunk.size());
+  for(size_t i = 0; i != chunk.size(); ++i){
+    const double  *v  = chunk.values.data() + chunk.offsets[i];
+    const size_t  nv  = chunk.offsets[i+1] - chunk.offsets[i];
+    Row           &r  = chunk.results[i];
+
+    // Rows with the wrong number of values are invalid
+    const size_t np = numParameters(opt.family);
+    if(nv < 2 || (np > 0 && nv != np+1)){
+      r = {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), 0, 0, -1};
+      continue;
+    } // End if invalid
+
+    const RowPoly   poly(v+1, nv-2);
+    const RowExp    ex(v[1], v[nv-1]);
+    const RowKepler kepler(v[1], v[nv-1]);
+    const Fun &f = opt.family == FamilyPoly ? static_cast<const Fun&>(poly) : opt.family == FamilyExp ? static_cast<const Fun&>(ex) : static_cast<const Fun&>(kepler);
+
+    const SolveResult s = opt.safeguarded ? solver.solveSafeguarded(f, v[0], ws) : solver.solve(f, v[0], ws);
+    r = {s.x, s.f, s.iterations, s.evaluations, s.status};
+  } // End for i
+}
+
+/// Parse the command line (returns false if it is not valid)
+
+bool parse(const int argc, char **argv, Options &opt){
+  for(int i = 1; i < argc; ++i){
+    const bool  Value = i+1 < argc;
+    const char  *a    = argv[i];
+    if     (!strcmp(a, "--input")    && Value){ opt.input   = argv[++i]; }
+    else if(!strcmp(a, "--output")   && Value){ opt.output  = argv[++i]; }
+    else if(!strcmp(a, "--convert")  && Value){ opt.convert = argv[++i]; }
+    else if(!strcmp(a, "--format")   && Value){
+      const std::string f = argv[++i];
+      if(f != "csv" && f != "bin"){ return false; }
+      opt.binary = f == "bin";
+    }
+    else if(!strcmp(a, "--family")   && Value){
+      const std::string f = argv[++i];
+      if     (f == "poly")  { opt.family = FamilyPoly;   }
+      else if(f == "exp")   { opt.family = FamilyExp;    }
+      else if(f == "kepler"){ opt.family = FamilyKepler; }
+      else{ return false; }
+    }
+    else if(!strcmp(a, "--tol")      && Value){ opt.tol      = atof(argv[++i]); }
+    else if(!strcmp(a, "--maxit")    && Value){ opt.maxit    = atol(argv[++i]); }
+    else if(!strcmp(a, "--nmax")     && Value){ opt.Nmax     = atol(argv[++i]); }
+    else if(!strcmp(a, "--strategy") && Value){ opt.strategy = atol(argv[++i]); }
+    else if(!strcmp(a, "--threads")  && Value){ opt.threads  = std::max(atol(argv[++i]), 0L); }
+    else if(!strcmp(a, "--chunk")    && Value){ opt.chunk    = std::max(atol(argv[++i]), 1L); }
+    else if(!strcmp(a, "--queue")    && Value){ opt.queue    = std::max(atol(argv[++i]), 1L); }
+    else if(!strcmp(a, "--safeguarded"))      { opt.safeguarded = true; }
+    else if(!strcmp(a, "--progress"))         { opt.progress    = true; }
+    else if(!strcmp(a, "--help") || !strcmp(a, "-h")){ opt.help = true; }
+    else{ return false; }
+  } // End for i
+  return true;
+}
+
+/// Convert problems in CSV format to the columnar binary format (in blocks of opt.chunk rows)
+
+int convert(std::istream &in, const Options &opt){
+  std::ofstream out(opt.convert, std::ios::binary);
+  CsvReader reader(in);
+  Chunk chunk;
+  std::vector<std::vector<double> > rows;
+  bool header = true;
+  size_t cols = 0;
+  while(true){
+    chunk.clear();
+    rows.clear();
+    while(chunk.size() != opt.chunk && reader.read(chunk)){
+      rows.emplace_back(chunk.values.begin() + chunk.offsets[chunk.size()-1], chunk.values.end());
+      if(cols == 0){ cols = rows.back().size(); }
+      if(rows.back().size() != cols || cols == 0){
+        std::cerr << "All rows must have the same (nonzero) number of values in the columnar binary format." << std::endl;
+        return EXIT_FAILURE;
+      } // End if the number of values differs
+    } // End while reading
+    if(rows.empty()){ break; }
+    BinaryReader::write(out, rows, header);
+    header = false;
+  } // End while true
+  return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/// Solve a stream of nonlinear algebraic equations using a pipeline of a reader, a pool of solver threads, and a writer
+
+int main(int argc, char **argv){
+  Options opt;
+  const bool Parsed = parse(argc, argv, opt);
+  if(!Parsed || opt.help){
+    (Parsed ? std::cout : std::cerr) << "Usage: " << argv[0] << " [--input FILE] [--output FILE] [--format csv|bin] [--family poly|exp|kepler]"
+              << " [--tol TOL] [--maxit MAXIT] [--nmax NMAX] [--strategy 1|2|3|4] [--safeguarded] [--threads T] [--chunk ROWS] [--queue CHUNKS] [--progress]"
+              << " [--convert FILE] [--help]" << std::endl;
+    return Parsed ? EXIT_SUCCESS : EXIT_FAILURE;
+  } // End if not parsed or help
+
+  try{
+    // Input and output streams
+    std::ifstream infile;
+    if(!opt.input.empty()){
+      infile.open(opt.input, std::ios::binary);
+      if(!infile){
+        std::cerr << "Unable to open " << opt.input << std::endl;
+        return EXIT_FAILURE;
+      } // End if not infile
+    } // End if input
+    std::istream &in = opt.input.empty() ? std::cin : infile;
+    if(!opt.convert.empty()){ return convert(in, opt); }
+
+    std::ofstream outfile;
+    if(!opt.output.empty()){
+      outfile.open(opt.output);
+      if(!outfile){
+        std::cerr << "Unable to open " << opt.output << std::endl;
+        return EXIT_FAILURE;
+      } // End if not outfile
+    } // End if output
+    std::ostream &out = opt.output.empty() ? std::cout : outfile;
+    out.precision(std::numeric_limits<double>::max_digits10);
+
+    const HiSolve solver(opt.tol, opt.maxit, opt.Nmax, true, opt.strategy);
+    const size_t nt = opt.threads > 0 ? opt.threads : std::max(std::thread::hardware_concurrency(), 1u);
+
+    // The chunks circulate from the free list to the reader, the solver threads, the writer, and back to the free list, i.e. the memory used is bounded by the number of chunks
+    const size_t nchunks = 2*opt.queue + nt;
+    std::vector<std::unique_ptr<Chunk> > storage;
+    BoundedQueue<Chunk*> idle(nchunks), todo(opt.queue), done(nchunks);
+    for(size_t i = 0; i != nchunks; ++i){
+      storage.emplace_back(new Chunk());
+      idle.push(storage.back().get());
+    } // End for i
+
+    // Reader
+    std::unique_ptr<CsvReader>    csv(opt.binary ? nullptr : new CsvReader(in));
+    std::unique_ptr<BinaryReader> bin(opt.binary ? new BinaryReader(in) : nullptr);
+    const char *error = nullptr;
+    std::thread reader([&]{
+      size_t seq = 0, first = 0;
+      Chunk *chunk;
+      try{
+        while(idle.pop(chunk)){
+          chunk->clear();
+          chunk->seq   = seq++;
+          chunk->first = first;
+          while(chunk->size() != opt.chunk && (csv ? csv->read(*chunk) : bin->read(*chunk))){}
+          first += chunk->size();
+          if(chunk->size() == 0){ break; }
+          todo.push(chunk);
+        } // End while idle chunks
+      }
+      catch(const char *e){
+        error = e;
+      } // End try
+      todo.close();
+    });
+
+    // Solver threads
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    size_t active = nt;
+    for(size_t t = 0; t != nt; ++t){
+      workers.emplace_back([&]{
+        HiSolveWorkspace ws(opt.Nmax);
+        Chunk *chunk;
+        while(todo.pop(chunk)){
+          solveChunk(solver, opt, ws, *chunk);
+          done.push(chunk);
+        } // End while chunks
+
+        // The last thread closes the queue of solved chunks
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--active == 0){ done.close(); }
+      });
+    } // End for t
+
+    // Writer (in the order of the input)
+    const auto start = std::chrono::steady_clock::now();
+    auto report = start;
+    std::map<size_t, Chunk*> pending;
+    size_t next = 0, rows = 0, converged = 0;
+    Chunk *chunk;
+    out << "index,x,f,status,iterations,evaluations\n";
+    while(done.pop(chunk)){
+      pending[chunk->seq] = chunk;
+      while(!pending.empty() && pending.begin()->first == next){
+        Chunk *c = pending.begin()->second;
+        pending.erase(pending.begin());
+        for(size_t i = 0; i != c->size(); ++i){
+          const Row &r = c->results[i];
+          out << c->first + i << ',' << r.x << ',' << r.f << ',' << statusName(r.status) << ',' << r.iterations << ',' << r.evaluations << '\n';
+          converged += r.status == SolveConverged;
+        } // End for i
+        rows += c->size();
+        ++next;
+        idle.push(c);
+      } // End while the next chunk is available
+
+      // Report the throughput
+      const auto now = std::chrono::steady_clock::now();
+      if(opt.progress && now - report > std::chrono::seconds(1)){
+        std::cerr << rows << " problems, " << rows/std::chrono::duration<double>(now - start).count() << " problems/s" << std::endl;
+        report = now;
+      } // End if report
+    } // End while solved chunks
+    idle.close();
+
+    reader.join();
+    for(std::thread &w : workers){ w.join(); }
+    out.flush();
+    if(error){ throw error; }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << rows << " problems (" << converged << " converged) in " << seconds << " s using " << nt << " solver threads: "
+              << (seconds > 0.0 ? rows/seconds : 0.0) << " problems/s" << std::endl;
+    return out ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  catch(const char *e){
+    std::cerr << e << std::endl;
+    return EXIT_FAILURE;
+  } // End try
+}
@@ -0,0 +1,410 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cstring> // For strcmp
+#include <cmath> // For exp, log, sin, cos, and fabs
+#include <cfloat> // For DBL_EPSILON
+#include <chrono> // For steady_clock
+#include <fstream> // For ofstream
+#include <iostream> // For cout, cerr, and endl
+#include <limits> // For std::numeric_limits
+#include <memory> // For std::unique_ptr
+#include <string> // For std::string
+#include <vector> // For std::vector
+
+// The library being benchmarked
+#include <hi-solve.h>
+#include <poly-fun.h>
+#include <taylor.h>
+
+/// Function object for exp(a*x) - b (for large values of a, the function is stiff)
+
+class ExpFun : public Fun {
+  private:
+    double a_, b_;
+
+  public:
+  ExpFun(const double a, const double b) : a_(a), b_(b) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    const double e = exp(a_*x);
+    double ak = 1.0;
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = ak*e;
+      ak   *= a_;
+    } // End for k
+    df[0] -= b_;
+  }
+};
+
+/// Function object for sin(x) - x/2
+
+class SineLinearFun : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    const double s = sin(x);
+    const double c = cos(x);
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = k%2 == 0 ? s : c;
+      if(k%4 > 1){ df[k] *= -1.0; }
+    } // End for k
+    df[0] -= 0.5*x;
+    if(N > 0){ df[1] -= 0.5; }
+  }
+};
+
+/// Function object for log(x) - 1
+
+class LogFun : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    df[0] = log(x) - 1.0;
+
+    // The k'th order derivative is (-1)^(k-1) (k-1)!/x^k
+    double d = 1.0/x;
+    for(size_t k = 1; k < N+1; ++k){
+      df[k] = d;
+      d    *= -double(k)/x;
+    } // End for k
+  }
+};
+
+/// Function object for exp(x) - 1 - x (which has a double root at 0)
+
+class ExpDoubleRootFun : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    const double e = exp(x);
+    for(size_t k = 0; k != N+1; ++k){ df[k] = e; }
+    df[0] -= 1.0 + x;
+    if(N > 0){ df[1] -= 1.0; }
+  }
+};
+
+/// Function object counting the number of evaluations of the function and the derivatives
+
+class CountingFun : public Fun {
+  private:
+    const Fun &f_;
+
+  public:
+    mutable size_t derivatives = 0; // Number of function values and derivatives evaluated
+
+  CountingFun(const Fun &f) : f_(f) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    derivatives += N+1;
+    f_.eval(x, N, df);
+  }
+
+  // Forward the staged protocol (only the additional derivatives are counted)
+  void evalMore(const double x, const size_t N0, const size_t N, DfSpan df) const override {
+    derivatives += N-N0;
+    f_.evalMore(x, N0, N, df);
+  }
+
+  bool hasStagedEval() const override { return f_.hasStagedEval(); }
+};
+
+/// Coefficients (in ascending order) of the monic polynomial with the given roots
+
+std::vector<double> polyFromRoots(const std::vector<double> &roots){
+  std::vector<double> a(1, 1.0);
+  for(const double r : roots){
+    a.push_back(0.0);
+    for(size_t i = a.size()-1; i != 0; --i){ a[i] = a[i-1] - r*a[i]; }
+    a[0] *= -r;
+  } // End for r
+  return a;
+}
+
+/// Move a function object to the heap (used for building the corpus)
+
+template<class F>
+std::unique_ptr<Fun> own(const F &f){ return std::unique_ptr<Fun>(new F(f)); }
+
+/// A test function in the corpus together with the initial guesses
+
+struct Problem {
+  std::string           name;   // Name of the function
+  std::string           family; // Family of functions (polynomial, transcendental, stiff, or multiple-root)
+  std::unique_ptr<Fun>  f;      // Function object
+  double                xmin;   // Smallest initial guess
+  double                xmax;   // Largest initial guess
+};
+
+/// Aggregated measurements for one configuration of the solver and one test function
+
+struct Measurement {
+  double  ns          = 0.0; // Time per solve in nanoseconds
+  double  evaluations = 0.0; // Function evaluations per solve
+  double  iterations  = 0.0; // Iterations per solve
+  double  derivatives = 0.0; // Function values and derivatives evaluated per solve (the unit of cost)
+  double  digits      = 0.0; // Digits gained per solve, i.e. log10(|f(x0)|/|f(x)|)
+  double  failures    = 0.0; // Fraction of solves which did not converge
+};
+
+/// Benchmark one configuration of the solver on one test function (using either the derivatives or the derivative-free variant)
+
+Measurement measure(const HiSolve &solver, const Fun &f, const std::vector<double> &x0, const size_t repetitions, const bool DerivativeFree){
+  Measurement m;
+  HiSolveWorkspace ws(solver.getNmax());
+  if(DerivativeFree){ ws.reserveValues(solver.derivativeFreeWorkspaceSize()); }
+  const double n = x0.size();
+
+  // Accounting (not timed, since the function evaluations are counted through an additional virtual call)
+  CountingFun counted(f);
+  for(const double x : x0){
+    // Function value at the initial guess
+    ws.reserve(solver.getNmax());
+    DfSpan df = ws.df(solver.getNmax());
+    f.eval(x, 0, df);
+    const double f0 = fabs(df[0]);
+
+    const SolveResult r = DerivativeFree ? solver.solveDerivativeFree(counted, x, ws) : solver.solve(counted, x, ws);
+    m.evaluations += r.evaluations;
+    m.iterations  += r.iterations;
+    if(r.converged()){
+      // The number of digits gained is limited by the machine precision
+      const double f1 = std::max(fabs(r.f), DBL_EPSILON*f0);
+      m.digits += f0 > 0.0 ? log10(f0/f1) : 0.0;
+    }
+    else{
+      m.failures += 1.0;
+    } // End if converged
+  } // End for x
+  m.derivatives = counted.derivatives/n;
+  m.evaluations /= n;
+  m.iterations  /= n;
+  m.digits      /= n;
+  m.failures    /= n;
+
+  // Timing
+  volatile double sink = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for(size_t rep = 0; rep != repetitions; ++rep){
+    for(const double x : x0){ sink = sink + (DerivativeFree ? solver.solveDerivativeFree(f, x, ws).x : solver.solve(f, x, ws).x); }
+  } // End for rep
+  const auto stop = std::chrono::steady_clock::now();
+  m.ns = std::chrono::duration<double, std::nano>(stop - start).count()/(repetitions*n);
+
+  return m;
+}
+
+/// Timings of the mixed-precision variants compared with the solvers in double for one configuration of the solver and one test function
+
+struct MixedMeasurement {
+  double  nsDouble        = 0.0; // Time per solve in double in nanoseconds
+  double  nsMixed         = 0.0; // Time per solve in mixed precision in nanoseconds
+  double  nsBatchDouble   = 0.0; // Time per equation of the batched solver in double in nanoseconds
+  double  nsBatchMixed    = 0.0; // Time per equation of the batched solver in mixed precision (float lanes) in nanoseconds
+  double  evaluations     = 0.0; // Function evaluations per solve in mixed precision (in float and double)
+  double  failuresDouble  = 0.0; // Fraction of solves in double which did not converge
+  double  failuresMixed   = 0.0; // Fraction of solves in mixed precision which did not converge
+};
+
+/// Benchmark the mixed-precision variants against the solvers in double on a polynomial (whose evaluation is generic in the scalar type)
+
+MixedMeasurement measureMixed(const HiSolve &solver, const PolyFun &p, const std::vector<double> &x0, const size_t repetitions){
+  MixedMeasurement m;
+  HiSolveWorkspace ws(solver.getNmax());
+  const double n = x0.size();
+  std::vector<double> x(x0.size());
+
+  // Callables which are generic in the scalar type
+  const auto f  = [&p](const auto x, const size_t N, auto *df){ p.evalGeneric(x, N, df); };
+  const auto fb = [&p](const auto *x, const size_t n, const size_t N, auto *df){ p.evalBatchGeneric(x, n, N, df); };
+
+  // Accounting (not timed)
+  for(const double x : x0){
+    const SolveResult rd = solver.solve(f, x, ws);
+    const SolveResult rm = solver.solveMixed(f, x, ws);
+    m.evaluations += rm.evaluations;
+    if(!rd.converged()){ m.failuresDouble += 1.0; }
+    if(!rm.converged()){ m.failuresMixed  += 1.0; }
+  } // End for x
+  m.evaluations     /= n;
+  m.failuresDouble  /= n;
+  m.failuresMixed   /= n;
+
+  // Timing (the same initial guesses are solved in double and in mixed precision)
+  volatile double sink = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for(size_t rep = 0; rep != repetitions; ++rep){
+    for(const double x : x0){ sink = sink + solver.solve(f, x, ws).x; }
+  } // End for rep
+  auto stop = std::chrono::steady_clock::now();
+  m.nsDouble = std::chrono::duration<double, std::nano>(stop - start).count()/(repetitions*n);
+
+  start = std::chrono::steady_clock::now();
+  for(size_t rep = 0; rep != repetitions; ++rep){
+    for(const double x : x0){ sink = sink + solver.solveMixed(f, x, ws).x; }
+  } // End for rep
+  stop = std::chrono::steady_clock::now();
+  m.nsMixed = std::chrono::duration<double, std::nano>(stop - start).count()/(repetitions*n);
+
+  start = std::chrono::steady_clock::now();
+  for(size_t rep = 0; rep != repetitions; ++rep){ sink = sink + solver.solveBatch(p, x0.size(), x0.data(), x.data()); }
+  stop = std::chrono::steady_clock::now();
+  m.nsBatchDouble = std::chrono::duration<double, std::nano>(stop - start).count()/(repetitions*n);
+
+  start = std::chrono::steady_clock::now();
+  for(size_t rep = 0; rep != repetitions; ++rep){ sink = sink + solver.solveBatchMixed(fb, x0.size(), x0.data(), x.data()); }
+  stop = std::chrono::steady_clock::now();
+  m.nsBatchMixed = std::chrono::duration<double, std::nano>(stop - start).count()/(repetitions*n);
+
+  return m;
+}
+
+/// Write a number to a JSON document (non-finite numbers are written as null)
+
+void writeNumber(std::ostream &out, const double v){
+  if(std::isfinite(v)){ out << v; } else{ out << "null"; }
+}
+
+/// Benchmark the update strategies, values of Nmax, and variants of the algorithm on a corpus of test functions and write the results in JSON format
+
+int main(int argc, char **argv){
+  // Command-line options
+  size_t      repetitions = 200;  // Number of times each set of initial guesses is solved
+  std::string output;             // Output file (stdout if empty)
+  for(int i = 1; i < argc; ++i){
+    if(!strcmp(argv[i], "--repetitions") && i+1 < argc){ repetitions = std::max(atol(argv[++i]), 1L); }
+    else if(!strcmp(argv[i], "--output") && i+1 < argc){ output = argv[++i]; }
+    else{
+      std::cerr << "Usage: " << argv[0] << " [--repetitions R] [--output FILE]" << std::endl;
+      return EXIT_FAILURE;
+    } // End if
+  } // End for i
+
+  // Highest-order derivatives used
+  const std::vector<size_t> Nmax = {1, 2, 3, 4, 6, 8, 12};
+  const size_t NmaxLargest = 12;
+
+  // Corpus of test functions
+  std::vector<Problem> corpus;
+  corpus.push_back({"cubic",          "polynomial",     own(PolyFun(polyFromRoots({1.0, 2.0, 3.0}))),                                                         -2.0, 6.0});
+  corpus.push_back({"wilkinson8",     "polynomial",     own(PolyFun(polyFromRoots({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0}))),                                 0.0, 9.0});
+  corpus.push_back({"exp",            "transcendental", own(ExpFun(1.0, 2.0)),                                                                                -2.0, 3.0});
+  corpus.push_back({"sin_linear",     "transcendental", own(SineLinearFun()),                                                                                  1.0, 3.0});
+  corpus.push_back({"log",            "transcendental", own(LogFun()),                                                                                         0.5, 8.0});
+  corpus.push_back({"lambert_taylor", "transcendental", own(makeTaylorFun<NmaxLargest+1>([](const auto &x){ return x*exp(x) - 1.0; })),                       -0.5, 2.0});
+  corpus.push_back({"exp_stiff",      "stiff",          own(ExpFun(25.0, 10.0)),                                                                              -0.5, 0.5});
+  corpus.push_back({"double_root",    "multiple-root",  own(ExpDoubleRootFun()),                                                                              -1.0, 1.0});
+  corpus.push_back({"triple_root",    "multiple-root",  own(PolyFun(polyFromRoots({1.0, 1.0, 1.0, -1.0}))),                                                    0.0, 3.0});
+
+  // Variants of the algorithm (the derivative-free variant only evaluates the function value, i.e. its cost in derivatives_per_solve is the number of evaluations)
+  const char *Variants[] = {"max-order", "variable-order", "derivative-free"};
+
+  // Initial guesses (equidistant in [xmin, xmax])
+  const size_t nx0 = 16;
+
+  // Write the results
+  std::ofstream file;
+  if(!output.empty()){
+    file.open(output);
+    if(!file){
+      std::cerr << "Unable to open " << output << std::endl;
+      return EXIT_FAILURE;
+    } // End if not file
+  } // End if output
+  std::ostream &out = output.empty() ? std::cout : file;
+  out.precision(std::numeric_limits<double>::max_digits10);
+
+  out << "{\n";
+  out << "  \"version\": \"" << HISOLVE_VERSION << "\",\n";
+  out << "  \"repetitions\": " << repetitions << ",\n";
+  out << "  \"initial_guesses\": " << nx0 << ",\n";
+  out << "  \"results\": [";
+
+  bool first = true;
+  for(const Problem &p : corpus){
+    std::vector<double> x0(nx0);
+    for(size_t i = 0; i != nx0; ++i){ x0[i] = p.xmin + i*(p.xmax - p.xmin)/(nx0 - 1); }
+
+    for(size_t strat = 1; strat != 5; ++strat){
+      for(const size_t nmax : Nmax){
+        for(size_t variant = 0; variant != 3; ++variant){
+          const HiSolve solver(1.0e-12, 50, nmax, variant == 0, strat);
+          const Measurement m = measure(solver, *p.f, x0, repetitions, variant == 2);
+
+          out << (first ? "\n" : ",\n");
+          out << "    {\"function\": \"" << p.name << "\", \"family\": \"" << p.family << "\"";
+          out << ", \"strategy\": " << strat << ", \"nmax\": " << nmax << ", \"variant\": \"" << Variants[variant] << "\"";
+          out << ", \"ns_per_solve\": ";                writeNumber(out, m.ns);
+          out << ", \"evaluations_per_solve\": ";       writeNumber(out, m.evaluations);
+          out << ", \"iterations_per_solve\": ";        writeNumber(out, m.iterations);
+          out << ", \"derivatives_per_solve\": ";       writeNumber(out, m.derivatives);
+          out << ", \"digits_per_derivative\": ";       writeNumber(out, m.derivatives > 0.0 ? m.digits/m.derivatives : 0.0);
+          out << ", \"digits_per_microsecond\": ";      writeNumber(out, m.ns > 0.0 ? 1.0e3*m.digits/m.ns : 0.0);
+          out << ", \"failure_rate\": ";                writeNumber(out, m.failures);
+          out << "}";
+          first = false;
+        } // End for variant
+      } // End for nmax
+    } // End for strat
+  } // End for p
+
+  out << "\n  ],\n";
+
+  // Mixed-precision variants compared with the solvers in double (speedup > 1 means that the mixed-precision variant is faster; the batches hold many initial guesses, such that the lanes fill the SIMD registers)
+  out << "  \"mixed_precision\": [";
+  first = true;
+  const size_t nbatch = 1024;
+  for(const Problem &p : corpus){
+    // Only the polynomials are generic in the scalar type
+    const PolyFun *poly = dynamic_cast<const PolyFun*>(p.f.get());
+    if(!poly){ continue; }
+
+    std::vector<double> x0(nbatch);
+    for(size_t i = 0; i != nbatch; ++i){ x0[i] = p.xmin + i*(p.xmax - p.xmin)/(nbatch - 1); }
+
+    for(size_t strat = 1; strat != 5; ++strat){
+      for(const size_t nmax : {2, 4}){
+        const HiSolve solver(1.0e-12, 50, nmax, true, strat);
+        const MixedMeasurement m = measureMixed(solver, *poly, x0, std::max(repetitions/100, size_t(1)));
+
+        out << (first ? "\n" : ",\n");
+        out << "    {\"function\": \"" << p.name << "\", \"strategy\": " << strat << ", \"nmax\": " << nmax;
+        out << ", \"ns_per_solve_double\": ";          writeNumber(out, m.nsDouble);
+        out << ", \"ns_per_solve_mixed\": ";           writeNumber(out, m.nsMixed);
+        out << ", \"speedup\": ";                      writeNumber(out, m.nsMixed > 0.0 ? m.nsDouble/m.nsMixed : 0.0);
+        out << ", \"ns_per_solve_batch_double\": ";    writeNumber(out, m.nsBatchDouble);
+        out << ", \"ns_per_solve_batch_mixed\": ";     writeNumber(out, m.nsBatchMixed);
+        out << ", \"speedup_batch\": ";                writeNumber(out, m.nsBatchMixed > 0.0 ? m.nsBatchDouble/m.nsBatchMixed : 0.0);
+        out << ", \"evaluations_per_solve_mixed\": ";  writeNumber(out, m.evaluations);
+        out << ", \"failure_rate_double\": ";          writeNumber(out, m.failuresDouble);
+        out << ", \"failure_rate_mixed\": ";           writeNumber(out, m.failuresMixed);
+        out << "}";
+        first = false;
+      } // End for nmax
+    } // End for strat
+  } // End for p
+
+  out << "\n  ]\n}\n";
+
+  return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -29,36 +29,7 @@ SOFTWARE.
 
 // The library being tested
 #include <hi-solve.h>
-
-/// A class implementing a polynomial
-
-class Poly : public Fun {
-  private:
-  const int m_;
-  const std::vector<double> a_;
-
-  public:
-  Poly(const std::vector<double> a, const int m) : a_(a), m_(m) {};
-
-  public:
-  void eval(const double x, const size_t N, std::vector<double> &dq) const override {
-    // Evaluate sine and its derivatives
-    for(int l = 0; l != N; ++l){
-      // Base value of the function value/derivative
-      dq[l] = 0.0;
-
-      for(int i = l+1; i != m_+1; ++i){
-        double fac = 1.0;
-
-        for(int k = 1; k != l+1; ++k){
-          fac *= i - k;
-        } // End for i
-
-        dq[l] += fac*a_[i-1]*pow(x, i-l-1);
-      } // End for l
-    } // End for k
-  }
-};
+#include <poly-fun.h>
 
 /// Test the solve function in HiSolve
 
@@ -66,18 +37,16 @@ int main(int argc, char **argv){
   // Order of the polynomial
   const int m = 31;
 
-  // Polynomial coefficients
+  // Polynomial coefficients (in ascending order)
   std::vector<double> a(m, 0.0);
 
   a[0] = 0.0;
-  for(int i = 1; i != m+1; ++i){
+  for(int i = 1; i != m; ++i){
     a[i] = pow(10.0, -i);
   } // End for i
 
-  // Create function object and vector for function evaluations
-  const Poly q(a, m);
-  std::vector<double> dq_mo(1);
-  std::vector<double> dq_vo(1);
+  // Create function object (all derivatives are evaluated using the extended Horner scheme)
+  const PolyFun q(a);
 
   // Highest order derivative to be used and tolerance
   const size_t Nmax   = 5;
@@ -87,6 +56,9 @@ int main(int argc, char **argv){
   // Simply create an object given the highest order number of derivatives to be evaluated
   HiSolve solver(Nmax);
 
+  // Workspace holding the function value and derivatives
+  HiSolveWorkspace ws(Nmax);
+
   // Set the tolerance and the maximum number of iterations
   solver.setTol   (tol  );
   solver.setMaxIt (maxit);
@@ -110,19 +82,17 @@ int main(int argc, char **argv){
         // Initial guess
         const double x0 = xmin + i*xinc;
 
-        // Solve for root using the maximum-order variant of the algorithm
+        // Solve for root using the maximum-order variant of the algorithm (the safeguarded variant stops early if the iterations diverge)
         solver.setUseMaxOrder(true);
-        const double xsol_mo = solver.solve(q, x0);
-        q.eval(xsol_mo, 0, dq_mo);
+        const double fsol_mo = solver.solveSafeguarded(q, x0, ws).f;
 
         // Solve for root using the variable-order variant of the algorithm
         solver.setUseMaxOrder(false);
-        const double xsol_vo = solver.solve(q, x0);
-        q.eval(xsol_vo, 0, dq_vo);
+        const double fsol_vo = solver.solveSafeguarded(q, x0, ws).f;
 
         // Report results
         std::cout << std::setprecision(2);
-        std::cout << dq_mo[0] << "/" << dq_vo[0] << " ";
+        std::cout << fsol_mo << "/" << fsol_vo << " ";
       } // End for i
       std::cout << std::endl;
     } // End for j
@@ -0,0 +1,175 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_BATCH_DRIVER_H
+#define HI_SOLVE_BATCH_DRIVER_H
+
+// Standard library headers
+#include <vector> // For std::vector
+#include <memory> // For std::unique_ptr
+#include <functional> // For std::function
+#include <thread> // For std::thread
+#include <mutex> // For std::mutex
+#include <condition_variable> // For std::condition_variable
+#include <exception> // For std::exception_ptr
+#include <cstddef> // For size_t
+
+// Solver and abstract function base class
+#include <hi-solve.h>
+
+/// Load-balance statistics of a single worker thread in BatchDriver
+
+struct BatchDriverStats {
+  size_t problems = 0;   ///< Number of problems solved by the thread
+  size_t chunks   = 0;   ///< Number of chunks processed by the thread
+  size_t steals   = 0;   ///< Number of times the thread stole work from another thread
+  double busyTime = 0.0; ///< Time (in seconds) spent processing chunks
+};
+
+/// A parallel driver for solving large batches of independent equations
+
+/**
+The driver owns a pool of worker threads. When a batch of n problems is solved, the indices 0, 1, ..., n-1 are split into one contiguous range per thread. Each thread repeatedly takes a chunk from the front of its own range, where the size of the chunk decreases as the range is exhausted (guided scheduling). When its own range is empty, a thread steals the back half of the remaining range of another thread. Consequently, the load is balanced even though the number of iterations varies a lot between problems.
+
+All threads share the (const) solver, each thread owns a workspace, and each problem is solved independently of the others. Consequently, the results are bit-identical regardless of the number of threads.
+
+@see HiSolve
+*/
+
+class BatchDriver {
+  /**
+  Type of the tasks, i.e. task(begin, end, ws) must solve the problems with indices begin, begin+1, ..., end-1 using the given workspace (which is owned by the calling thread)
+  */
+  public:
+  typedef std::function<void(const size_t, const size_t, HiSolveWorkspace&)> Task;
+
+  // Internal data structure for each worker thread
+  private:
+  struct Worker {
+    std::mutex        mutex;      // Protects the range of indices
+    size_t            begin;      // First index in the range of remaining problems
+    size_t            end;        // One past the last index in the range of remaining problems
+    HiSolveWorkspace  workspace;  // Workspace owned by the thread
+    BatchDriverStats  stats;      // Load-balance statistics
+
+    Worker(const size_t Nmax) : begin(0), end(0), workspace(Nmax) {}
+  };
+
+  // Internal data members
+  private:
+    HiSolve                   solver_;      // Solver shared by all threads
+    std::vector<std::unique_ptr<Worker> > workers_; // Worker data
+    std::vector<std::thread>  threads_;     // Worker threads
+    size_t                    MinChunk_;    // Smallest number of problems in a chunk
+    std::mutex                mutex_;       // Protects the members below
+    std::condition_variable   start_;       // Signals the start of a batch (or that the threads must stop)
+    std::condition_variable   done_;        // Signals that all threads have finished a batch
+    size_t                    generation_;  // Number of batches started
+    size_t                    active_;      // Number of threads still working on the current batch
+    bool                      stop_;        // Whether or not the threads must stop
+    const Task               *task_;        // Task of the current batch
+    std::exception_ptr        error_;       // First exception thrown by a task in the current batch
+
+  /**
+  Constructor starting the worker threads
+
+  @param[in] solver   solver used by all threads
+  @param[in] nthreads number of worker threads (if 0, the number of hardware threads is used)
+  @param[in] MinChunk smallest number of problems in a chunk
+  */
+  public:
+  BatchDriver(const HiSolve &solver, const size_t nthreads = 0, const size_t MinChunk = 16);
+
+  /**
+  Destructor stopping the worker threads
+  */
+  public:
+  ~BatchDriver();
+
+  // The driver owns threads, so it cannot be copied
+  BatchDriver(const BatchDriver&) = delete;
+  BatchDriver &operator=(const BatchDriver&) = delete;
+
+  /**
+  Get the number of worker threads
+
+  @returns the number of worker threads
+  */
+  public:
+  size_t getNumThreads() const { return threads_.size(); }
+
+  /**
+  Get the solver used by all threads
+
+  @returns the solver
+  */
+  public:
+  const HiSolve &getSolver() const { return solver_; }
+
+  /**
+  Get the load-balance statistics of each thread for the most recent batch
+
+  @returns the statistics (one entry per thread)
+  */
+  public:
+  std::vector<BatchDriverStats> getStats() const;
+
+  /**
+  Solve a batch of n independent problems in parallel
+
+  If a task throws an exception, the remaining problems are still processed, and the first exception is rethrown.
+
+  @param[in] n    number of problems
+  @param[in] task the task solving a chunk of problems (see Task)
+  */
+  public:
+  void run(const size_t n, const Task &task);
+
+  /**
+  Solve the equation f(x) = 0 from each of n initial guesses in parallel
+
+  @param[in]  f  function object
+  @param[in]  n  number of initial guesses
+  @param[in]  x0 initial guesses (n values)
+  @param[out] x  approximate solutions (n values)
+  */
+  public:
+  void solve(const Fun &f, const size_t n, const double *x0, double *x);
+
+  /**
+  Internal function executed by each worker thread
+  */
+  private:
+  void work(const size_t id);
+
+  /**
+  Internal function returning the next chunk of problems for a given thread (taken from its own range or stolen from another thread)
+
+  @returns false if there are no more problems
+  */
+  private:
+  bool next(const size_t id, size_t &begin, size_t &end);
+};
+
+#endif
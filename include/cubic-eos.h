@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_CUBIC_EOS_H
+#define HI_SOLVE_CUBIC_EOS_H
+
+// Standard library headers
+#include <cstddef> // For size_t
+
+// Solver providing the update strategies
+#include <hi-solve.h>
+
+/// Root branches of a cubic equation of state
+
+/**
+The values can be combined as bit flags, i.e. CubicEosTwoPhase = CubicEosLiquid | CubicEosVapor.
+*/
+
+enum CubicEosBranch {
+  CubicEosFailed   = 0, ///< The iterations did not converge
+  CubicEosLiquid   = 1, ///< A single (liquid-like) real root
+  CubicEosVapor    = 2, ///< A single (vapor-like) real root
+  CubicEosTwoPhase = 3  ///< Three real roots (distinct liquid-like and vapor-like roots)
+};
+
+/// A batched solver for cubic equations of state
+
+/**
+This class solves many cubic equations of state (e.g. Peng-Robinson or Soave-Redlich-Kwong) in the compressibility factor Z,
+
+  Z^3 + c2*Z^2 + c1*Z + c0 = 0,
+
+simultaneously in SIMD lanes. The derivatives of a cubic are exact and cheap, so all lanes are evaluated in every iteration (converged lanes are masked), and the updates are computed using the batched update strategies of HiSolve (always using the maximum-order variant). For each cubic, one root is computed from the initial guess. Unless warm starts are used, the initial guess is placed on the side of the largest root where the cubic is monotone and has constant curvature (using the location of the local minimum), such that the iterations cannot be trapped close to a local extremum; lanes in which a warm start fails are restarted in the same way. The cubic is then deflated to a quadratic in order to determine whether there are one or three real roots, and the smallest (liquid-like) and largest (vapor-like) roots are polished using the same iterations. If there is a single real root, it is classified as liquid-like if it lies to the left of the inflection point, -c2/3, and as vapor-like otherwise.
+
+This is the class of problems which inspired the high-order method (Olivera-Fuentes, 1993).
+
+@see HiSolve
+*/
+
+class CubicEos {
+  // Internal data members
+  private:
+    HiSolve solver_; // Solver providing the tolerance, the maximum number of iterations, Nmax, and the update strategy
+
+  /**
+  Constructor
+
+  @param[in] solver solver providing the tolerance, the maximum number of iterations, the highest-order derivative used (derivatives above order 3 vanish), and the update strategy
+  */
+  public:
+  CubicEos(const HiSolve &solver) : solver_(solver) {}
+
+  /**
+  Compute the coefficients of the Peng-Robinson equation of state,
+
+    Z^3 - (1 - B)*Z^2 + (A - 3*B^2 - 2*B)*Z - (A*B - B^2 - B^3) = 0
+
+  @param[in]  n  number of cubics
+  @param[in]  A  dimensionless attraction parameters (n values)
+  @param[in]  B  dimensionless co-volume parameters (n values)
+  @param[out] c2 coefficients of Z^2 (n values)
+  @param[out] c1 coefficients of Z (n values)
+  @param[out] c0 constant coefficients (n values)
+  */
+  public:
+  static void pengRobinson(const size_t n, const double *A, const double *B, double *c2, double *c1, double *c0);
+
+  /**
+  Compute the coefficients of the Soave-Redlich-Kwong equation of state,
+
+    Z^3 - Z^2 + (A - B - B^2)*Z - A*B = 0
+
+  @param[in]  n  number of cubics
+  @param[in]  A  dimensionless attraction parameters (n values)
+  @param[in]  B  dimensionless co-volume parameters (n values)
+  @param[out] c2 coefficients of Z^2 (n values)
+  @param[out] c1 coefficients of Z (n values)
+  @param[out] c0 constant coefficients (n values)
+  */
+  public:
+  static void soaveRedlichKwong(const size_t n, const double *A, const double *B, double *c2, double *c1, double *c0);
+
+  /**
+  Solve a batch of n cubic equations of state for their liquid-like (smallest) and vapor-like (largest) real roots
+
+  @param[in]    n         number of cubics
+  @param[in]    c2        coefficients of Z^2 (n values)
+  @param[in]    c1        coefficients of Z (n values)
+  @param[in]    c0        constant coefficients (n values)
+  @param[out]   Zl        liquid-like roots (n values)
+  @param[inout] Zv        vapor-like roots (n values, used as initial guesses in case of a warm start, e.g. the roots from the previous time step)
+  @param[out]   branch    the root branch of each cubic (see CubicEosBranch, ignored if null)
+  @param[in]    WarmStart whether or not to use Zv as initial guesses
+
+  @returns the number of cubics which were solved successfully
+  */
+  public:
+  size_t solve(const size_t n, const double *c2, const double *c1, const double *c0, double *Zl, double *Zv, unsigned char *branch = nullptr, const bool WarmStart = false) const;
+
+  /**
+  Internal function iterating on a block of n cubics until all lanes have converged or the maximum number of iterations is reached
+
+  @param[in]    n  number of cubics
+  @param[in]    c2 coefficients of Z^2 (n values)
+  @param[in]    c1 coefficients of Z (n values)
+  @param[in]    c0 constant coefficients (n values)
+  @param[inout] Z  initial guesses and approximate roots (n values)
+  @param[out]   ok whether or not each lane converged (n values)
+  @param[out]   df workspace for function values and derivatives ((Nmax+1)*n values)
+  @param[out]   dx workspace for the updates (n values)
+  @param[out]   aux workspace for the update strategies (n values)
+  */
+  private:
+  void iterate(const size_t n, const double *c2, const double *c1, const double *c0, double *Z, unsigned char *ok, double *df, double *dx, double *aux) const;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_DOUBLE_DOUBLE_H
+#define HI_SOLVE_DOUBLE_DOUBLE_H
+
+// Standard library headers
+#include <cmath> // For fma, fabs, and isfinite
+
+/// A double-double number, i.e. an unevaluated sum of two doubles with about 32 significant digits
+
+/**
+The value is hi + lo, where |lo| <= ulp(hi)/2. The arithmetic operations use error-free transformations (Dekker and Knuth), i.e. only standard double-precision operations and fused multiply-add. This type is used by HiSolve::solveMixed for polishing solutions when the tolerance is close to machine precision.
+*/
+
+class DoubleDouble {
+  public:
+    double hi; ///< The leading part
+    double lo; ///< The trailing part
+
+  /**
+  Constructor (implicit conversion from double)
+
+  @param[in] h the value
+  */
+  public:
+  DoubleDouble(const double h = 0.0) : hi(h), lo(0.0) {}
+
+  /**
+  Constructor from a leading and a trailing part (which are normalized)
+
+  @param[in] h the leading part
+  @param[in] l the trailing part
+  */
+  public:
+  DoubleDouble(const double h, const double l) : hi(h + l), lo(l - (hi - h)) {}
+
+  /**
+  Conversion to double (the leading part)
+  */
+  public:
+  explicit operator double() const { return hi; }
+
+  /**
+  Error-free sum, i.e. a + b = s + e exactly
+  */
+  public:
+  static DoubleDouble twoSum(const double a, const double b){
+    DoubleDouble r;
+    r.hi = a + b;
+    const double v = r.hi - a;
+    r.lo = (a - (r.hi - v)) + (b - v);
+    return r;
+  }
+
+  /**
+  Error-free product, i.e. a*b = p + e exactly
+  */
+  public:
+  static DoubleDouble twoProd(const double a, const double b){
+    DoubleDouble r;
+    r.hi = a*b;
+    r.lo = std::fma(a, b, -r.hi);
+    return r;
+  }
+
+  // Arithmetic operations
+  public:
+  DoubleDouble operator-() const { DoubleDouble r; r.hi = -hi; r.lo = -lo; return r; }
+
+  friend DoubleDouble operator+(const DoubleDouble &a, const DoubleDouble &b){
+    DoubleDouble s = twoSum(a.hi, b.hi);
+    const DoubleDouble t = twoSum(a.lo, b.lo);
+    s = DoubleDouble(s.hi, s.lo + t.hi);
+    return DoubleDouble(s.hi, s.lo + t.lo);
+  }
+
+  friend DoubleDouble operator-(const DoubleDouble &a, const DoubleDouble &b){ return a + (-b); }
+
+  friend DoubleDouble operator*(const DoubleDouble &a, const DoubleDouble &b){
+    const DoubleDouble p = twoProd(a.hi, b.hi);
+    return DoubleDouble(p.hi, p.lo + (a.hi*b.lo + a.lo*b.hi));
+  }
+
+  friend DoubleDouble operator/(const DoubleDouble &a, const DoubleDouble &b){
+    // Long division with two quotient digits
+    const double q1 = a.hi/b.hi;
+    const DoubleDouble r = a - b*DoubleDouble(q1);
+    const double q2 = r.hi/b.hi;
+    const DoubleDouble s = r - b*DoubleDouble(q2);
+    const double q3 = s.hi/b.hi;
+    return DoubleDouble(q1, q2) + DoubleDouble(q3);
+  }
+
+  DoubleDouble &operator+=(const DoubleDouble &b){ return *this = *this + b; }
+  DoubleDouble &operator-=(const DoubleDouble &b){ return *this = *this - b; }
+  DoubleDouble &operator*=(const DoubleDouble &b){ return *this = *this * b; }
+  DoubleDouble &operator/=(const DoubleDouble &b){ return *this = *this / b; }
+
+  // Comparisons
+  public:
+  friend bool operator==(const DoubleDouble &a, const DoubleDouble &b){ return a.hi == b.hi && a.lo == b.lo; }
+  friend bool operator!=(const DoubleDouble &a, const DoubleDouble &b){ return !(a == b); }
+  friend bool operator< (const DoubleDouble &a, const DoubleDouble &b){ return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+  friend bool operator> (const DoubleDouble &a, const DoubleDouble &b){ return b < a; }
+  friend bool operator<=(const DoubleDouble &a, const DoubleDouble &b){ return !(b < a); }
+  friend bool operator>=(const DoubleDouble &a, const DoubleDouble &b){ return !(a < b); }
+
+  // Mathematical functions (found using argument-dependent lookup)
+  public:
+  friend DoubleDouble fabs(const DoubleDouble &a){ return a.hi < 0.0 ? -a : a; }
+  friend bool isfinite(const DoubleDouble &a){ return std::isfinite(a.hi) && std::isfinite(a.lo); }
+};
+
+#endif
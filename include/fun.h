@@ -25,6 +25,76 @@ SOFTWARE.
 #ifndef HI_SOLVE_FUN_H
 #define HI_SOLVE_FUN_H
 
+// Standard library headers
+#include <vector> // For std::vector
+#include <cstddef> // For size_t
+
+/// A non-owning view of the function value and derivatives
+
+/**
+The k'th element is stored at data[k*stride], i.e. the view can refer to a contiguous array (e.g. the storage of a std::vector or of a HiSolveWorkspace) or to one lane of an array in structure-of-arrays layout (see Fun::evalBatch). Creating a view never allocates memory.
+*/
+
+class DfSpan {
+  // Internal data members
+  private:
+    double  *data_;   // Pointer to the first element
+    size_t  size_;    // Number of elements
+    size_t  stride_;  // Distance between consecutive elements
+
+  /**
+  Constructor
+
+  @param[in] data   pointer to the first element
+  @param[in] size   number of elements
+  @param[in] stride distance between consecutive elements
+  */
+  public:
+  DfSpan(double *data, const size_t size, const size_t stride = 1) : data_(data), size_(size), stride_(stride) {}
+
+  /**
+  Constructor creating a view of all elements in a vector
+
+  @param[in] df the vector
+  */
+  public:
+  DfSpan(std::vector<double> &df) : data_(df.data()), size_(df.size()), stride_(1) {}
+
+  /**
+  Access the k'th element
+
+  @param[in] k the index of the element (i.e. the order of the derivative)
+
+  @returns a reference to the k'th element
+  */
+  public:
+  double &operator[](const size_t k) const { return data_[k*stride_]; }
+
+  /**
+  Get the number of elements
+
+  @returns the number of elements
+  */
+  public:
+  size_t size() const { return size_; }
+
+  /**
+  Get the distance between consecutive elements
+
+  @returns the stride
+  */
+  public:
+  size_t stride() const { return stride_; }
+
+  /**
+  Get the pointer to the first element
+
+  @returns the pointer to the first element
+  */
+  public:
+  double *data() const { return data_; }
+};
+
 /// An abstract class representing a scalar-valued function
 
 /**
@@ -39,10 +109,73 @@ class Fun {
 
   @param[in]  x   the scalar value to evaluate the function at
   @param[in]  N   the highest-order derivative to be evaluated
-  @param[out] df  the values of the function and its derivatives
+  @param[out] df  the values of the function and its derivatives (holds at least N+1 elements)
+  */
+  public:
+  virtual void eval(const double x, const size_t N, DfSpan df) const = 0;
+
+  /**
+  Evaluate the function and up to (and including) its N'th order derivative for a batch of n scalar values
+
+  The results are stored in structure-of-arrays (SoA) layout, i.e. the k'th order derivative evaluated at x[i] is stored in dfSoA[k*n + i]. The default implementation simply calls eval once for each of the n values (using strided views of dfSoA). Override it if the function can be evaluated for several values at once (e.g. using SIMD instructions).
+
+  @param[in]  x     the n scalar values to evaluate the function at
+  @param[in]  n     the number of scalar values
+  @param[in]  N     the highest-order derivative to be evaluated
+  @param[out] dfSoA the values of the function and its derivatives (must hold at least (N+1)*n values)
+  */
+  public:
+  virtual void evalBatch(const double *x, const size_t n, const size_t N, double *dfSoA) const {
+    for(size_t i = 0; i != n; ++i){
+      // Evaluate the function and its derivatives directly into the i'th lane
+      eval(x[i], N, DfSpan(dfSoA + i, N+1, n));
+    } // End for i
+  }
+
+  /**
+  Evaluate additional derivatives at the same scalar value (staged evaluation)
+
+  The function value and derivatives up to (and including) order N0 have already been evaluated at x by eval (or evalMore) and are stored in df[0], ..., df[N0]. This function evaluates the derivatives of order N0+1, ..., N, and it may reuse the lower-order values. The default implementation simply calls eval(x, N, df).
+
+  HiSolve only uses the staged protocol, i.e. it evaluates the function value first and only requests the derivatives once it is known that they are needed for the next update, if hasStagedEval returns true. Override both functions if the derivatives are expensive compared to the function value.
+
+  @param[in]    x   the scalar value to evaluate the function at
+  @param[in]    N0  the highest-order derivative which has already been evaluated
+  @param[in]    N   the highest-order derivative to be evaluated
+  @param[inout] df  the values of the function and its derivatives (holds at least N+1 elements)
+  */
+  public:
+  virtual void evalMore(const double x, const size_t, const size_t N, DfSpan df) const { eval(x, N, df); }
+
+  /**
+  Evaluate additional derivatives at the same n scalar values (staged evaluation, see evalMore and evalBatch)
+
+  @param[in]    x     the n scalar values to evaluate the function at
+  @param[in]    n     the number of scalar values
+  @param[in]    N0    the highest-order derivative which has already been evaluated
+  @param[in]    N     the highest-order derivative to be evaluated
+  @param[inout] dfSoA the values of the function and its derivatives in SoA layout (must hold at least (N+1)*n values)
+  */
+  public:
+  virtual void evalBatchMore(const double *x, const size_t n, const size_t N0, const size_t N, double *dfSoA) const {
+    for(size_t i = 0; i != n; ++i){
+      evalMore(x[i], N0, N, DfSpan(dfSoA + i, N+1, n));
+    } // End for i
+  }
+
+  /**
+  Get whether or not HiSolve should use the staged protocol (see evalMore)
+
+  @returns true if evalMore is cheaper than evaluating all derivatives again
+  */
+  public:
+  virtual bool hasStagedEval() const { return false; }
+
+  /**
+  Virtual destructor
   */
   public:
-  virtual void eval(const double x, const size_t N, std::vector<double> &df) const = 0;
+  virtual ~Fun() {}
 };
 
 #endif
@@ -0,0 +1,227 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_ASYNC_H
+#define HI_SOLVE_ASYNC_H
+
+// Standard library headers
+#include <chrono> // For std::chrono::seconds
+#include <cstddef> // For size_t
+#include <future> // For std::future
+#include <vector> // For std::vector
+
+// Solver and abstract function base class
+#include <hi-solve.h>
+
+/// Abstract base class for functions which are evaluated asynchronously (e.g. by an external simulator)
+
+/**
+Instead of blocking until the function value and derivatives are available, evalAsync requests the evaluation and returns a future which becomes ready when the values have been stored. This allows HiSolveScheduler to keep many evaluations outstanding at once, such that the throughput is bounded by the capacity of the evaluator rather than by its latency.
+
+@see HiSolveScheduler, LatencyFun
+*/
+
+class AsyncFun {
+  /**
+  Destructor
+  */
+  public:
+  virtual ~AsyncFun() {}
+
+  /**
+  Request the evaluation of the function value and derivatives
+
+  @param[in]  x  the point at which the function is evaluated
+  @param[in]  N  the highest-order derivative to evaluate
+  @param[out] df storage for the function value and the derivatives up to (and including) order N (must remain valid until the future is ready)
+
+  @returns a future which becomes ready when df has been stored (or which holds the exception thrown by the evaluation)
+  */
+  public:
+  virtual std::future<void> evalAsync(const double x, const size_t N, DfSpan df) const = 0;
+};
+
+/// A solve which is suspended while the function is being evaluated
+
+/**
+The iterations are the same as in HiSolve::solve (without the staged protocol or the adaptive-order variant), but the loop is turned inside out: start requests the first evaluation, and each call to resume consumes the completed evaluation, checks for termination, computes the update, and requests the next evaluation. Each resumable solve owns the storage for its function value and derivatives, so many solves can be suspended at the same time.
+
+@see HiSolveScheduler
+*/
+
+class HiSolveResumable {
+  // Internal data members
+  private:
+    double              tol_;         // Tolerance
+    size_t              maxit_;       // Maximum number of iterations
+    size_t              Nmax_;        // Highest-order derivative used
+    bool                UseMaxOrder_; // Whether or not the maximum-order variant is used
+    size_t              Strategy_;    // Update strategy
+    std::vector<double> df_;          // Function value and derivatives
+    double              x_;           // Current approximate solution
+    size_t              it_;          // Iteration counter
+    size_t              Avail_;       // Highest-order derivative being (or having been) evaluated
+    bool                done_;        // Whether or not the solve has terminated
+    SolveResult         result_;      // Result (complete when done_ is true)
+    std::future<void>   pending_;     // The outstanding evaluation
+
+  /**
+  Constructor
+
+  @param[in] solver the solver whose settings are used (the adaptive-order variant is not supported)
+  */
+  public:
+  HiSolveResumable(const HiSolve &solver);
+
+  /**
+  Start a new solve by requesting the first evaluation
+
+  @param[in] f  the function
+  @param[in] x0 the initial guess
+  */
+  public:
+  void start(const AsyncFun &f, const double x0);
+
+  /**
+  Get whether or not the outstanding evaluation has completed (waiting for at most a given time)
+
+  @param[in] timeout the longest time to wait for the evaluation (the default does not block)
+
+  @returns true if resume will not block
+  */
+  public:
+  bool ready(const std::chrono::microseconds timeout = std::chrono::microseconds(0)) const { return pending_.wait_for(timeout) == std::future_status::ready; }
+
+  /**
+  Wait for the outstanding evaluation and continue the solve until the next evaluation is requested or the iterations terminate
+
+  Exceptions thrown by the evaluation are rethrown.
+
+  @param[in] f the function (the same as in start)
+
+  @returns true if a new evaluation was requested, and false if the solve has terminated
+  */
+  public:
+  bool resume(const AsyncFun &f);
+
+  /**
+  Wait for the outstanding evaluation (if any) and terminate the solve without a result (e.g. because another solve failed)
+  */
+  public:
+  void abandon();
+
+  /**
+  Get whether or not the solve has terminated
+
+  @returns true if the solve has terminated
+  */
+  public:
+  bool done() const { return done_; }
+
+  /**
+  Get the result of a terminated solve (SolveResult::df is empty because the storage is reused by the next solve)
+
+  @returns the result
+  */
+  public:
+  const SolveResult &result() const { return result_; }
+
+  // Request the evaluation needed in the current iteration
+  private:
+  void request(const AsyncFun &f);
+};
+
+/// A scheduler interleaving many resumable solves of an asynchronously evaluated function
+
+/**
+Up to MaxInFlight solves are in flight at once, each suspended at its function evaluation. Whenever an evaluation completes, the corresponding solve is resumed and either requests its next evaluation or terminates, in which case the next problem is started in its place. Completed evaluations are resumed in the order in which they complete, so a slow evaluation does not hold back the others. If none has completed, the scheduler waits for at most PollInterval on each of the outstanding evaluations in turn before checking all of them again, i.e. an evaluation which completes while the scheduler waits for another one is resumed within PollInterval.
+
+The scheduler runs in the calling thread; the concurrency is provided by the evaluator. Each problem is solved independently of the others, so the results do not depend on MaxInFlight or on the order in which the evaluations complete.
+
+@see AsyncFun, HiSolveResumable
+*/
+
+class HiSolveScheduler {
+  /// The longest time the scheduler waits for one evaluation while the others may have completed
+  public:
+  static constexpr std::chrono::microseconds PollInterval = std::chrono::microseconds(50);
+
+  // Internal data members
+  private:
+    HiSolve   solver_;      // Solver whose settings are used
+    size_t    MaxInFlight_; // Largest number of solves in flight
+
+  /**
+  Constructor
+
+  @param[in] solver      the solver whose settings are used (the adaptive-order variant is not supported)
+  @param[in] MaxInFlight largest number of solves in flight (must be positive)
+  */
+  public:
+  HiSolveScheduler(const HiSolve &solver, const size_t MaxInFlight = 256) : solver_(solver), MaxInFlight_(MaxInFlight) {
+    if(MaxInFlight == 0){
+      throw "The number of solves in flight must be positive.";
+    } // End if MaxInFlight == 0
+  }
+
+  /**
+  Get the largest number of solves in flight
+
+  @returns the largest number of solves in flight
+  */
+  public:
+  size_t getMaxInFlight() const { return MaxInFlight_; }
+
+  /**
+  Solve n independent problems
+
+  If an evaluation throws, the scheduler waits for the other outstanding evaluations and rethrows the exception.
+
+  @param[in]  f       the function
+  @param[in]  n       number of problems
+  @param[in]  x0      initial guesses (n values)
+  @param[out] results results (n values, SolveResult::df is empty)
+
+  @returns the number of problems for which the iterations converged
+  */
+  public:
+  size_t solve(const AsyncFun &f, const size_t n, const double *x0, SolveResult *results) const;
+
+  /**
+  Solve independent problems
+
+  @param[in] f  the function
+  @param[in] x0 initial guesses
+
+  @returns the results (SolveResult::df is empty)
+  */
+  public:
+  std::vector<SolveResult> solve(const AsyncFun &f, const std::vector<double> &x0) const {
+    std::vector<SolveResult> results(x0.size());
+    solve(f, x0.size(), x0.data(), results.data());
+    return results;
+  }
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_CONTINUATION_H
+#define HI_SOLVE_CONTINUATION_H
+
+// Standard library headers
+#include <cstddef> // For size_t
+#include <vector> // For std::vector
+
+// Solver and abstract function base class
+#include <hi-solve.h>
+
+/// An abstract class representing a family of functions f(x; p) depending on a scalar parameter p
+
+/**
+This class is used by the HiSolveContinuation class for tracking a root x(p) as the parameter changes. You need to implement a class deriving from this abstract base class to represent the specific family that you want to solve.
+
+@see HiSolveContinuation
+*/
+
+class ParamFun {
+  /**
+  Destructor
+  */
+  public:
+  virtual ~ParamFun() {}
+
+  /**
+  Evaluate the function value and the derivatives with respect to x
+
+  @param[in]  x  the point at which the function is evaluated
+  @param[in]  p  the parameter
+  @param[in]  N  the highest-order derivative to evaluate
+  @param[out] df the function value and the derivatives up to (and including) order N
+  */
+  public:
+  virtual void eval(const double x, const double p, const size_t N, DfSpan df) const = 0;
+
+  /**
+  Evaluate the derivative with respect to the parameter
+
+  @param[in] x the point at which the derivative is evaluated
+  @param[in] p the parameter
+
+  @returns the partial derivative of f with respect to p
+  */
+  public:
+  virtual double evalParam(const double x, const double p) const = 0;
+};
+
+/// A member of a family of functions for a fixed value of the parameter
+
+/**
+This class adapts a ParamFun to the Fun interface, such that HiSolve can solve f(x; p) = 0 for a given p.
+
+@see ParamFun
+*/
+
+class FixedParamFun : public Fun {
+  // Internal data members
+  private:
+    const ParamFun &f_; // The family of functions (must outlive the object)
+    double          p_; // The parameter
+
+  /**
+  Constructor
+
+  @param[in] f the family of functions
+  @param[in] p the parameter
+  */
+  public:
+  FixedParamFun(const ParamFun &f, const double p) : f_(f), p_(p) {}
+
+  /**
+  Evaluate the function value and its derivatives with respect to x for the fixed parameter
+
+  @param[in]  x  the scalar value to evaluate the function at
+  @param[in]  N  the highest-order derivative to be evaluated
+  @param[out] df the values of the function and its derivatives
+  */
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override { f_.eval(x, p_, N, df); }
+};
+
+/// Reasons for terminating the continuation
+
+enum ContinuationStatus {
+  ContinuationCompleted,    ///< The root has been tracked to the last parameter value
+  ContinuationTurningPoint, ///< The branch turns back (the derivative with respect to x vanishes) before the next parameter value
+  ContinuationBranchLost    ///< The corrector could not find the root on the branch even with the smallest step
+};
+
+/// The result of tracking a root across a sequence of parameter values
+
+struct ContinuationResult {
+  std::vector<double> x;                  ///< The roots at the parameter values reached, i.e. x[j] is the root at the j'th parameter value
+  ContinuationStatus  status      = ContinuationBranchLost; ///< The reason for terminating the continuation
+  double              p           = 0.0;  ///< The parameter value of the last point accepted on the branch
+  double              xLast       = 0.0;  ///< The root at the last point accepted on the branch
+  double              dxdp        = 0.0;  ///< The tangent of the branch at the last point accepted
+  size_t              steps       = 0;    ///< The number of steps accepted
+  size_t              rejected    = 0;    ///< The number of steps rejected
+  size_t              iterations  = 0;    ///< The number of iterations of the corrector (including rejected steps)
+  size_t              evaluations = 0;    ///< The number of function evaluations (including the evaluations of the tangent)
+
+  /**
+  Get whether or not the root was tracked to the last parameter value
+
+  @returns true if the continuation completed
+  */
+  bool completed() const { return status == ContinuationCompleted; }
+};
+
+/// Tracking of a root branch across a sequence of parameter values using predictor-corrector steps
+
+/**
+Instead of solving f(x; p) = 0 from the same initial guess for each parameter value, the root is tracked along the branch x(p). Each step of length h in p predicts the root and corrects the prediction using HiSolve::solve (with at most MaxCorrections iterations).
+
+The predictor uses the tangent dx/dp = -(df/dp)/(df/dx) given by the implicit function theorem (df/dx is reused from the last evaluation of the corrector if it is available). After the first step, the predictor is the cubic Hermite extrapolation of the last two points and their tangents (which is exact to third order in h), and the first step uses the tangent line.
+
+A step is rejected, and the step length halved, if the corrector does not converge within MaxCorrections iterations, if the derivative with respect to x changes sign (i.e. the corrector has passed a turning point or jumped to another branch), or if the secant of the step disagrees with the trapezoidal rule applied to the tangents at its ends (i.e. the corrector has jumped to another branch). The step length is doubled after a step which needed at most MaxCorrections/2 iterations, and the steps end exactly at the requested parameter values.
+
+If the step length falls below MinStep, the continuation terminates. If the tangent is steepening, the branch is approaching a turning point (where dx/dp is infinite), and otherwise the branch is lost.
+
+@see HiSolve, ParamFun
+*/
+
+class HiSolveContinuation {
+  // Internal data members
+  private:
+    HiSolve solver_;          // Solver used by the corrector
+    size_t  MaxCorrections_;  // Largest number of corrector iterations in an accepted step
+    double  MinStep_;         // Smallest step length in the parameter
+
+  /**
+  Constructor
+
+  @param[in] solver         solver used by the corrector (and for the root at the first parameter value)
+  @param[in] MaxCorrections largest number of corrector iterations in an accepted step (must be positive)
+  @param[in] MinStep        smallest step length in the parameter (must be positive)
+  */
+  public:
+  HiSolveContinuation(const HiSolve &solver, const size_t MaxCorrections = 4, const double MinStep = 1.0e-10) : solver_(solver), MaxCorrections_(MaxCorrections), MinStep_(MinStep) {
+    if(MaxCorrections == 0 || !(MinStep > 0.0)){
+      throw "The number of corrections and the smallest step must be positive.";
+    } // End if MaxCorrections or MinStep is not positive
+  }
+
+  /**
+  Get the solver used by the corrector
+
+  @returns the solver
+  */
+  public:
+  const HiSolve &getSolver() const { return solver_; }
+
+  /**
+  Track a root across a sequence of parameter values
+
+  @param[in] f  the family of functions
+  @param[in] x0 initial guess of the root at the first parameter value
+  @param[in] p  the parameter values (in any order, but consecutive values should lie on the same branch)
+
+  @returns the result (with the roots at the parameter values reached)
+  */
+  public:
+  ContinuationResult track(const ParamFun &f, const double x0, const std::vector<double> &p) const;
+};
+
+#endif
@@ -0,0 +1,598 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_ENGINE_H
+#define HI_SOLVE_ENGINE_H
+
+// Standard library headers
+#include <array> // For std::array
+#include <cmath> // For fabs
+#include <cstddef> // For size_t
+#include <type_traits> // For std::decay
+#include <utility> // For std::index_sequence and std::declval
+#include <vector> // For std::vector
+
+// Abstract function base class (and DfSpan)
+#include <fun.h>
+
+// Result of solving an equation
+#include <solve-result.h>
+
+// Tracing policies
+#include <hi-solve-trace.h>
+
+/// Get a view of the first n function values and derivatives stored in df (used for SolveResult::df, which is empty unless the values are stored as doubles)
+
+inline DfSpan hiSolveView(double *df, const size_t n){ return DfSpan(df, n); }
+
+template<class T>
+inline DfSpan hiSolveView(T*, const size_t){ return DfSpan(nullptr, 0); }
+
+template<class DfT>
+inline DfSpan hiSolveView(DfT &df, const size_t n){ return hiSolveView(&df[0], n); }
+
+inline DfSpan hiSolveView(const DfSpan &df, const size_t n){ return DfSpan(df.data(), n, df.stride()); }
+
+inline DfSpan hiSolveView(DfSpan &df, const size_t n){ return DfSpan(df.data(), n, df.stride()); }
+
+/// Compute the update given by the root of the [1/N-1] Pade approximant of the Taylor polynomial of the function (update strategy 4)
+
+/**
+The Taylor polynomial f(x + d) = a_0 + a_1*d + ... + a_N*d^N, a_k = f^(k)(x)/k!, is replaced by the rational function (p_0 + p_1*d)/(1 + q_1*d + ... + q_{N-1}*d^(N-1)) which agrees with it up to order N, and the update is the root of its (linear) numerator. This is Householder's method of order N+1, i.e. the update is b_{N-1}/b_N, where b_k are the Taylor coefficients of 1/f. The coefficients are computed by the recurrence b_k = -(a_1*b_{k-1} + ... + a_k*b_0)/a_0 in scaled form, i.e. beta_k = b_k*a_0*r^k with the Newton-step r = -a_0/a_1, such that they neither overflow nor underflow as f approaches zero. For N = 1 and N = 2, the update is the Newton-step and the Halley-step, respectively.
+
+If tolDx is positive, no more terms are added once the correction of the update is below tolDx (see HiSolve::setAdaptiveOrder).
+
+@param[in]  df    the function value and derivatives
+@param[in]  N     number of terms to include in the approximation
+@param[out] work  workspace (2*(N+1) values)
+@param[in]  tolDx tolerance for the corrections (zero to use all N terms)
+
+@returns the update
+*/
+
+template<class DfT, class T>
+inline T hiSolvePadeUpdate(const DfT &df, const size_t N, T *work, const double tolDx = 0.0){
+  using std::fabs;
+
+  // Newton-step
+  const T r = -df[0]/df[1];
+  T dx = r;
+  if(N < 2){ return dx; }
+
+  // Scaled Taylor coefficients of f and 1/f
+  T *alpha = work;
+  T *beta  = work + (N+1);
+  const T rdf0 = T(1.0)/df[0];
+  T rk = r;
+  double invfac = 1.0;
+  alpha[1] = T(-1.0);
+  beta [0] = T(1.0);
+  beta [1] = T(1.0);
+
+  // Modify Newton-step using higher-order derivatives
+  for(size_t k = 2; k <= N; ++k){
+    rk     *= r;
+    invfac /= k;
+    alpha[k] = df[k]*T(invfac)*rk*rdf0;
+
+    T sum = T(0.0);
+    for(size_t j = 1; j <= k; ++j){ sum -= alpha[j]*beta[k-j]; }
+    beta[k] = sum;
+
+    // The approximant has no finite root if beta[k] vanishes
+    if(beta[k] == T(0.0)){ break; }
+
+    // Update Newton-step and stop adding terms once the correction is below the tolerance
+    const T    dxk   = r*beta[k-1]/beta[k];
+    const bool Small = tolDx > 0.0 && fabs(dxk - dx) < T(tolDx);
+    dx = dxk;
+    if(Small){ break; }
+  } // End for k
+
+  return dx;
+}
+
+/// Number of values in the workspace of hiSolvePade which is stored on the stack (covers N + 2 <= HiSolveWorkspace::InlineSize, see the static assertion in hi-solve.h)
+
+constexpr size_t HiSolvePadeInlineSize = 64;
+
+/// Compute the update of strategy 4 (see hiSolvePadeUpdate) using a workspace on the stack unless N is large
+
+/**
+HiSolve does not use this function when it solves with a HiSolveWorkspace, which provides the scratch values instead (see HiSolveWorkspace::work).
+
+@param[in] df    the function value and derivatives
+@param[in] N     number of terms to include in the approximation
+@param[in] tolDx tolerance for the corrections (zero to use all N terms)
+
+@returns the update
+*/
+
+template<class DfT>
+inline typename std::decay<decltype(std::declval<const DfT&>()[0])>::type hiSolvePade(const DfT &df, const size_t N, const double tolDx = 0.0){
+  typedef typename std::decay<decltype(df[0])>::type T;
+
+  // Memory is only allocated on the heap for 2*(N + 1) > HiSolvePadeInlineSize
+  T inline_[HiSolvePadeInlineSize];
+  if(2*(N+1) <= HiSolvePadeInlineSize){ return hiSolvePadeUpdate(df, N, inline_, tolDx); }
+  std::vector<T> heap(2*(N+1));
+  return hiSolvePadeUpdate(df, N, heap.data(), tolDx);
+}
+
+/// Compute an approximate high-order update using update strategy 1, 2, or 3 (the kernel shared by HiSolve, HiSolveEngine, and the batched solvers)
+
+/**
+All solvers compute the updates of strategies 1, 2, and 3 using this function (or, for the batched solvers, the same arithmetic lane by lane), such that the compile-time specialized engine and the update strategy chosen at run time give bit-identical iterates.
+
+If MaxTerms is positive, it is a compile-time bound on N, i.e. the loop has a compile-time trip count and is fully unrolled (used by HiSolveEngine).
+
+If tolDx is positive, no more terms are added once the correction of the update is below tolDx (see HiSolve::setAdaptiveOrder).
+
+@tparam    MaxTerms compile-time bound on N (zero if N is not bounded at compile time)
+@param[in] Strategy which update strategy to use (1, 2, or 3)
+@param[in] df       the function value and derivatives
+@param[in] N        number of terms to include in the approximation
+@param[in] tolDx    tolerance for the corrections (zero to use all N terms)
+
+@returns the update
+*/
+
+template<size_t MaxTerms = 0, class DfT>
+inline typename std::decay<decltype(std::declval<const DfT&>()[0])>::type hiSolveTaylorUpdate(const size_t Strategy, const DfT &df, const size_t N, const double tolDx = 0.0){
+  typedef typename std::decay<decltype(df[0])>::type T;
+  using std::fabs;
+
+  // Newton-step (strategy 1 does not modify the Newton-step)
+  T dx = -df[0]/df[1];
+  if(Strategy == 1){ return dx; }
+
+  // Auxiliary variables (the factorials are exact in double precision for the numbers of terms used in practice)
+  T aux = T(1.0);
+  double fac = 1.0;
+
+  // Modify Newton-step using higher-order derivatives
+  const size_t K = MaxTerms > 0 ? MaxTerms : N;
+#pragma GCC unroll 16
+  for(size_t k = 1; k < K; ++k){
+    if(k >= N){ break; }
+
+    // Update auxiliary factors
+    if(Strategy == 2){
+      aux = T(1.0);
+#pragma GCC unroll 16
+      for(size_t l = 0; l != k; ++l){ aux *= dx; }
+    }
+    else{
+      aux *= dx;
+    } // End if Strategy == 2
+    fac *= k+1;
+
+    // Update Newton-step and stop adding terms once the correction is below the tolerance
+    const T    dxk   = T(1.0)/(T(1.0)/dx - aux*df[k+1]/(T(fac)*df[0]));
+    const bool Small = tolDx > 0.0 && fabs(dxk - dx) < T(tolDx);
+    dx = dxk;
+    if(Small){ break; }
+  } // End for k
+
+  return dx;
+}
+
+/// Compute an approximate high-order update using a given update strategy (1, 2, 3, or 4) in the scalar type used for storing the function value and derivatives (e.g. float, double, or DoubleDouble)
+
+/**
+@param[in] Strategy which update strategy to use (1, 2, 3, or 4)
+@param[in] df       the function value and derivatives
+@param[in] N        number of terms to include in the approximation
+
+@returns the update
+*/
+
+template<class DfT>
+inline typename std::decay<decltype(std::declval<const DfT&>()[0])>::type hiSolveUpdate(const size_t Strategy, const DfT &df, const size_t N){
+  // Root of the Pade approximant
+  if(Strategy == 4){ return hiSolvePade(df, N); }
+
+  return hiSolveTaylorUpdate(Strategy, df, N);
+}
+
+/// Strided view of the function value and derivatives of a single lane in SoA layout
+
+template<class T>
+struct HiSolveLaneDf {
+  const T *df; // Function value of the lane
+  size_t   n;  // Number of lanes
+
+  T operator[](const size_t k) const { return df[k*n]; }
+};
+
+/// Compute approximate high-order updates for a batch of n lanes using a given update strategy (1, 2, 3, or 4) in the scalar type of the lanes (e.g. float or double)
+
+/**
+The loops over the lanes have no data-dependent trip counts (except for strategy 4), so the compiler vectorizes them, i.e. twice as many lanes are processed per instruction in float as in double. For each lane, the arithmetic is the same as in hiSolveUpdate.
+
+@param[in]  Strategy which update strategy to use (1, 2, 3, or 4)
+@param[in]  N        number of terms to include in the approximation
+@param[in]  n        number of lanes
+@param[in]  df       function values and derivatives in SoA layout, i.e. the k'th order derivative of the i'th lane is df[k*n + i]
+@param[out] dx       the updates (n values)
+@param[out] aux      auxiliary workspace (n values, only used by strategy 3)
+*/
+
+template<class T>
+inline void hiSolveUpdateBatch(const size_t Strategy, const size_t N, const size_t n, const T *df, T *dx, T *aux){
+  // The recurrence of the Pade approximant has a data-dependent trip count, so the lanes are processed one by one
+  if(Strategy == 4){
+    for(size_t i = 0; i != n; ++i){
+      dx[i] = hiSolvePade(HiSolveLaneDf<T>{df + i, n}, N);
+    } // End for i
+    return;
+  } // End if Strategy == 4
+
+  // Newton-step (strategy 1 does not modify the Newton-step)
+  for(size_t i = 0; i != n; ++i){
+    dx[i] = -df[i]/df[n+i];
+  } // End for i
+  if(Strategy == 1){ return; }
+
+  // Auxiliary variables
+  double fac = 1.0;
+  if(Strategy == 3){
+    for(size_t i = 0; i != n; ++i){
+      aux[i] = T(1.0);
+    } // End for i
+  } // End if Strategy == 3
+
+  // Modify Newton-step using higher-order derivatives
+  for(size_t k = 1; k < N; ++k){
+    // Update auxiliary factor
+    fac *= k+1;
+
+    const T *dfk = df + (k+1)*n;
+    if(Strategy == 2){
+      // Update Newton-step (the power is computed by repeated multiplication as in hiSolveTaylorUpdate, such that the lanes agree with the scalar solvers)
+      for(size_t i = 0; i != n; ++i){
+        T power = T(1.0);
+        for(size_t l = 0; l != k; ++l){ power *= dx[i]; }
+        dx[i] = T(1.0)/(T(1.0)/dx[i] - power*dfk[i]/(T(fac)*df[i]));
+      } // End for i
+    }
+    else{
+      // Update Newton-step
+      for(size_t i = 0; i != n; ++i){
+        aux[i] *= dx[i];
+        dx [i]  = T(1.0)/(T(1.0)/dx[i] - aux[i]*dfk[i]/(T(fac)*df[i]));
+      } // End for i
+    } // End if Strategy == 2
+  } // End for k
+}
+
+/// The iterations of the high-order method shared by HiSolve and HiSolveEngine
+
+/**
+The iterations are terminated when the function value is below the tolerance, when the maximum number of iterations is reached, when the approximate solution or the function value is not finite, or when the first-order derivative is zero (such that the next update cannot be computed).
+
+If Staged is true, only the function value is evaluated at each new approximate solution, and the derivatives are requested (using more) once it is known that the iterations continue, i.e. no derivatives are evaluated at the converged solution (see Fun::evalMore).
+
+@param[in]    eval   callable evaluating the function and its derivatives, i.e. eval(x, N, df) stores the function value and up to (and including) the N'th order derivative in df
+@param[in]    more   callable evaluating additional derivatives, i.e. more(x, N0, N, df) stores the derivatives of order N0+1, ..., N in df (only used if Staged is true)
+@param[in]    Staged whether or not to use the staged protocol
+@param[in]    update callable computing the update, i.e. update(df, N) uses N terms
+@param[in]    terms  callable returning the number of terms used in a given iteration
+@param[in]    order  callable returning the order of the highest-order derivative to be used for a given number of terms
+@param[inout] df     storage for the function value and derivatives
+@param[inout] x      initial guess on entry and approximate solution on exit (of the same scalar type as the values in df, e.g. float, double, or DoubleDouble)
+@param[in]    tol    tolerance for terminating the iterations
+@param[in]    maxit  maximum number of iterations
+@param[inout] trace  tracing policy (see HiSolveTrace), whose hooks are called around the function evaluations and after each update (the hooks of HiSolveNoTrace are empty, i.e. they cost nothing)
+
+@returns the result (SolveResult::df is a view of df if the values are stored as doubles)
+*/
+
+template<class Eval, class More, class Update, class Terms, class Order, class DfT, class T, class Trace>
+inline SolveResult hiSolveIterate(Eval &&eval, More &&more, const bool Staged, Update &&update, Terms &&terms, Order &&order, DfT &df, T &x, const double tol, const size_t maxit, Trace &trace){
+  using std::isfinite;
+  using std::fabs;
+  SolveResult result;
+
+  // Evaluate the function (and the derivatives needed in the first iteration unless the staged protocol is used)
+  size_t it     = 0;
+  size_t Order0 = order(terms(it));
+  size_t Avail  = Staged ? 0 : Order0;
+  trace.beginSolve();
+  trace.beginEval();
+  eval(x, Avail, df);
+  trace.endEval();
+  result.evaluations  = 1;
+  result.order        = Avail;
+
+  // Iterate until termination
+  while(true){
+    // Check for termination
+    if(!isfinite(x) || !isfinite(df[0]))          { result.status = SolveNonFinite;       break; }
+    if(fabs(df[0]) < tol)                         { result.status = SolveConverged;       break; }
+    if(it == maxit)                               { result.status = SolveMaxIterations;   break; }
+
+    // Evaluate the derivatives needed for the update
+    if(Avail < Order0){
+      trace.beginEval();
+      more(x, Avail, Order0, df);
+      trace.endEval();
+      Avail = Order0;
+      if(Order0 > result.order){ result.order = Order0; }
+    } // End if Avail < Order0
+
+    if(df[1] == 0.0)                              { result.status = SolveZeroDerivative;  break; }
+
+    // Increment the iteration counter
+    ++it;
+
+    // Compute update and update approximation of solution
+    const T dx = update(df, terms(it));
+    trace.iteration(it, x, df[0], dx, Avail, terms(it), [&](const size_t N){ return update(df, N); });
+    x += dx;
+
+    // Evaluate the function and its derivatives
+    Order0 = order(terms(it));
+    Avail  = Staged ? 0 : Order0;
+    trace.beginEval();
+    eval(x, Avail, df);
+    trace.endEval();
+    ++result.evaluations;
+    if(Avail > result.order){ result.order = Avail; }
+  } // End while true
+
+  result.x          = static_cast<double>(x);
+  result.f          = static_cast<double>(df[0]);
+  result.df         = hiSolveView(df, Avail+1);
+  result.iterations = it;
+
+  return result;
+}
+
+/// The iterations of the high-order method shared by HiSolve and HiSolveEngine (without tracing, see hiSolveIterate above)
+
+template<class Eval, class More, class Update, class Terms, class Order, class DfT, class T>
+inline SolveResult hiSolveIterate(Eval &&eval, More &&more, const bool Staged, Update &&update, Terms &&terms, Order &&order, DfT &df, T &x, const double tol, const size_t maxit){
+  HiSolveNoTrace trace;
+  return hiSolveIterate(eval, more, Staged, update, terms, order, df, x, tol, maxit, trace);
+}
+
+/// A header-only, compile-time specialized version of the high-order method implemented in HiSolve
+
+/**
+The highest-order derivative used, the update strategy, and the variant of the algorithm are template parameters. Consequently, the loops in the update strategies have compile-time trip counts and are fully unrolled by the compiler (the running product of the factorials is constant-folded), and the function values and derivatives can be stored in a std::array. HiSolve::solve dispatches to pre-instantiated specializations of this class template whenever Nmax is small enough (see HiSolve::NmaxSpecialized).
+
+@tparam Nmax         highest-order derivative used
+@tparam Strategy     which update strategy to use (1, 2, 3, or 4)
+@tparam UseMaxOrder  whether or not to use the maximum-order variant of the algorithm
+
+@see HiSolve
+*/
+
+template<size_t Nmax, size_t Strategy, bool UseMaxOrder>
+class HiSolveEngine {
+  static_assert(Nmax > 0, "Nmax must be positive");
+  static_assert(Strategy >= 1 && Strategy <= 4, "Unknown value of Strategy. Please use 1, 2, 3, or 4.");
+
+  /**
+  Number of function values and derivatives used (the variable-order variant evaluates up to order Nmax+1)
+  */
+  public:
+  static constexpr size_t Size = Nmax + 2;
+
+  /**
+  Type used for storing the function value and derivatives
+  */
+  public:
+  typedef std::array<double, Size> Df;
+
+  /**
+  Solve a nonlinear algebraic equation
+
+  @param[in]    eval  callable evaluating the function and its derivatives, i.e. eval(x, N, df) stores the function value and up to (and including) the N'th order derivative in df
+  @param[inout] df    storage for the function value and derivatives (e.g. Df or std::vector<double>)
+  @param[in]    x0    initial guess
+  @param[in]    tol   tolerance for terminating the iterations
+  @param[in]    maxit maximum number of iterations
+
+  @returns the result (see hiSolveIterate)
+  */
+  public:
+  template<class Eval, class DfT>
+  static SolveResult solve(Eval &&eval, DfT &df, const double x0, const double tol, const size_t maxit){
+    const auto more = [](const double, const size_t, const size_t, DfT&){};
+    return solveStaged(eval, more, false, df, x0, tol, maxit);
+  }
+
+  /**
+  Solve a nonlinear algebraic equation using the staged protocol for evaluating the derivatives if Staged is true (see hiSolveIterate)
+
+  @param[in]    eval   callable evaluating the function and its derivatives
+  @param[in]    more   callable evaluating additional derivatives, i.e. more(x, N0, N, df) stores the derivatives of order N0+1, ..., N in df
+  @param[in]    Staged whether or not to use the staged protocol
+  @param[inout] df     storage for the function value and derivatives
+  @param[in]    x0     initial guess
+  @param[in]    tol    tolerance for terminating the iterations
+  @param[in]    maxit  maximum number of iterations
+
+  @returns the result (see hiSolveIterate)
+  */
+  public:
+  template<class Eval, class More, class DfT>
+  static SolveResult solveStaged(Eval &&eval, More &&more, const bool Staged, DfT &df, const double x0, const double tol, const size_t maxit){
+    HiSolveNoTrace trace;
+    return solveStaged(eval, more, Staged, df, x0, tol, maxit, trace);
+  }
+
+  /**
+  Solve a nonlinear algebraic equation and call the hooks of a tracing policy (see hiSolveIterate)
+
+  @param[in]    eval   callable evaluating the function and its derivatives
+  @param[in]    more   callable evaluating additional derivatives
+  @param[in]    Staged whether or not to use the staged protocol
+  @param[inout] df     storage for the function value and derivatives
+  @param[in]    x0     initial guess
+  @param[in]    tol    tolerance for terminating the iterations
+  @param[in]    maxit  maximum number of iterations
+  @param[inout] trace  tracing policy (e.g. HiSolveTrace)
+
+  @returns the result (see hiSolveIterate)
+  */
+  public:
+  template<class Eval, class More, class DfT, class Trace>
+  static SolveResult solveStaged(Eval &&eval, More &&more, const bool Staged, DfT &df, const double x0, const double tol, const size_t maxit, Trace &trace){
+    const auto upd    = [](const DfT &df, const size_t N){ return update(df, N); };
+    const auto terms  = [](const size_t it){ return N(it); };
+    const auto order  = [](const size_t N){ return Order(N); };
+    double x = x0;
+    return hiSolveIterate(eval, more, Staged, upd, terms, order, df, x, tol, maxit, trace);
+  }
+
+  /**
+  Solve a nonlinear algebraic equation using a std::array for storing the function value and derivatives
+
+  @param[in] eval  callable evaluating the function and its derivatives, i.e. eval(x, N, df) with df of type Df
+  @param[in] x0    initial guess
+  @param[in] tol   tolerance for terminating the iterations
+  @param[in] maxit maximum number of iterations
+
+  @returns the approximate solution
+  */
+  public:
+  template<class Eval>
+  static double solve(Eval &&eval, const double x0, const double tol, const size_t maxit){
+    Df df = {};
+    return solve(eval, df, x0, tol, maxit).x;
+  }
+
+  /**
+  Compute an approximate high-order update using the update strategy given by the template parameter Strategy
+
+  @param[in] df the function value and derivatives
+  @param[in] N  number of terms to include in the approximation (at most Nmax)
+
+  @returns the update
+  */
+  public:
+  template<class DfT>
+  static typename std::decay<decltype(std::declval<const DfT&>()[0])>::type update(const DfT &df, const size_t N){
+    typedef typename std::decay<decltype(df[0])>::type T;
+
+    // Root of the Pade approximant (the workspace has a compile-time size, so the number of terms is bounded by Nmax)
+    if(Strategy == 4){
+      const size_t Nc = N < Nmax ? N : Nmax;
+      std::array<T, 2*(Nmax+1)> work;
+      return hiSolvePadeUpdate(df, Nc, work.data());
+    } // End if Strategy == 4
+
+    // Strategies 1, 2, and 3 (with a compile-time trip count)
+    return hiSolveTaylorUpdate<Nmax>(Strategy, df, N);
+  }
+
+  /**
+  Internal function returning the number of terms used in a given iteration
+
+  @param[in] it the iteration number
+
+  @returns the number of terms to use
+  */
+  public:
+  static constexpr size_t N(const size_t it){ return UseMaxOrder ? Nmax : (it < Nmax ? it : Nmax); }
+
+  /**
+  Internal function returning the order of the highest-order derivative to be used
+
+  @param[in] N the number of terms to be used
+
+  @returns the order of the highest-order derivative to be used
+  */
+  public:
+  static constexpr size_t Order(const size_t N){ return UseMaxOrder ? N : N+1; }
+};
+
+/// Runtime dispatch onto pre-instantiated specializations of HiSolveEngine
+
+/**
+The class template Entry must provide a static member function called solve for each combination of Nmax (1, 2, ..., NmaxSpecialized), update strategy (1, 2, 3, or 4), and variant of the algorithm. A pointer to each of these functions is stored in a table which is constructed the first time lookup is called.
+
+@tparam Entry           class template wrapping a specialization of HiSolveEngine
+@tparam NmaxSpecialized largest value of Nmax which is pre-instantiated
+*/
+
+template<template<size_t, size_t, bool> class Entry, size_t NmaxSpecialized>
+class HiSolveDispatch {
+  /**
+  Type of the pointers to the pre-instantiated functions
+  */
+  public:
+  typedef decltype(&Entry<1, 1, true>::solve) Pointer;
+
+  /**
+  Look up the specialization corresponding to a given configuration
+
+  @param[in] Nmax         highest-order derivative used (1, 2, ..., NmaxSpecialized)
+  @param[in] Strategy     which update strategy to use (1, 2, 3, or 4)
+  @param[in] UseMaxOrder  whether or not to use the maximum-order variant of the algorithm
+
+  @returns a pointer to the specialization
+  */
+  public:
+  static Pointer lookup(const size_t Nmax, const size_t Strategy, const bool UseMaxOrder){
+    typedef std::make_index_sequence<NmaxSpecialized> Indices;
+    static const Pointer *tables[2][4] = {
+      { table<1, false>(Indices()), table<2, false>(Indices()), table<3, false>(Indices()), table<4, false>(Indices()) },
+      { table<1, true >(Indices()), table<2, true >(Indices()), table<3, true >(Indices()), table<4, true >(Indices()) }};
+
+    return tables[UseMaxOrder][Strategy-1][Nmax-1];
+  }
+
+  /**
+  Internal function returning the table of specializations for Nmax = 1, 2, ..., NmaxSpecialized
+  */
+  private:
+  template<size_t Strategy, bool UseMaxOrder, size_t... I>
+  static const Pointer *table(std::index_sequence<I...>){
+    static const Pointer t[] = { &Entry<I+1, Strategy, UseMaxOrder>::solve... };
+    return t;
+  }
+};
+
+/// Wrapper of HiSolveEngine used by HiSolve for solving equations represented by generic callables
+
+/**
+@tparam F type of the callable, i.e. f(x, N, df) stores the function value and up to (and including) the N'th order derivative in the array pointed to by df
+*/
+
+template<class F>
+struct HiSolveCallable {
+  template<size_t Nmax, size_t Strategy, bool UseMaxOrder>
+  struct Entry {
+    static SolveResult solve(F &f, const DfSpan &df, const double x0, const double tol, const size_t maxit){
+      const auto eval = [&f](const double x, const size_t N, const DfSpan &df){ f(x, N, df.data()); };
+      return HiSolveEngine<Nmax, Strategy, UseMaxOrder>::solve(eval, df, x0, tol, maxit);
+    }
+  };
+};
+
+#endif
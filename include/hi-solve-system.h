@@ -0,0 +1,320 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_SYSTEM_H
+#define HI_SOLVE_SYSTEM_H
+
+// Standard library headers
+#include <array> // For std::array
+#include <cmath> // For fabs and isfinite
+#include <cstddef> // For size_t
+#include <utility> // For std::swap
+
+// Reasons for terminating the iterations
+#include <solve-result.h>
+
+/// An abstract class representing a vector-valued function of n variables (a system of n nonlinear algebraic equations)
+
+/**
+This class is used by the HiSolveSystem class for evaluating the residual, the Jacobian, and the directional derivatives of higher order. You need to implement a class deriving from this abstract base class to represent the specific system that you want to solve.
+
+@tparam n the number of equations and unknowns
+
+@see HiSolveSystem
+*/
+
+template<size_t n>
+class FunSystem {
+  /**
+  Type used for storing vectors (the residual, the approximate solution, and the directions)
+  */
+  public:
+  typedef std::array<double, n> Vec;
+
+  /**
+  Type used for storing the Jacobian (in row-major order, i.e. J[i*n + j] is the derivative of the i'th equation with respect to the j'th unknown)
+  */
+  public:
+  typedef std::array<double, n*n> Mat;
+
+  /**
+  Evaluate the residual and the Jacobian
+
+  @param[in]  x the unknowns
+  @param[out] F the residual
+  @param[out] J the Jacobian
+  */
+  public:
+  virtual void eval(const Vec &x, Vec &F, Mat &J) const = 0;
+
+  /**
+  Evaluate the k'th order directional derivative of the residual, i.e. the k'th order derivative tensor contracted with the direction k times (d^k/dt^k F(x + t*v) at t = 0)
+
+  The default implementation returns zero, i.e. the high-order corrections vanish and HiSolveSystem reduces to Newton's method. Override it if the higher-order derivatives are available.
+
+  @param[in]  x the unknowns
+  @param[in]  k the order of the derivative (at least 2)
+  @param[in]  v the direction
+  @param[out] d the directional derivative
+  */
+  public:
+  virtual void evalDirectional(const Vec &, const size_t, const Vec &, Vec &d) const { d.fill(0.0); }
+
+  /**
+  Virtual destructor
+  */
+  public:
+  virtual ~FunSystem() {}
+};
+
+/// The result of solving a system of nonlinear algebraic equations
+
+template<size_t n>
+struct SystemResult {
+  std::array<double, n> x;                  ///< The approximate solution
+  std::array<double, n> F;                  ///< The residual at the approximate solution
+  size_t      iterations  = 0;              ///< The number of (outer) iterations, i.e. the number of LU factorizations
+  size_t      evaluations = 0;              ///< The number of evaluations of the residual and the Jacobian
+  size_t      directional = 0;              ///< The number of evaluations of directional derivatives
+  SolveStatus status      = SolveMaxIterations; ///< The reason for terminating the iterations (SolveZeroDerivative if the Jacobian is singular)
+
+  /**
+  Get whether or not the iterations converged
+
+  @returns true if the iterations converged
+  */
+  bool converged() const { return status == SolveConverged; }
+};
+
+/// A class for solving small systems of nonlinear algebraic equations using high-order methods
+
+/**
+This class is the multivariate counterpart of HiSolve. The high-order update solves the truncated Taylor expansion
+
+  0 = F + J*dx + D^2F[dx, dx]/2! + ... + D^NF[dx, ..., dx]/N!
+
+where D^kF[dx, ..., dx] is the k'th order directional derivative (see FunSystem::evalDirectional), using the LU factorization of the Jacobian J, which is computed once in each iteration and reused for all corrections:
+
+  - Strategy 1 (Newton): dx = -J^{-1}*F.
+  - Strategy 2 (Chebyshev-type): the directional derivatives are evaluated in the direction of the Newton-step, dxn, i.e. dx = dxn - J^{-1}*sum_k D^kF[dxn, ..., dxn]/k!. For Nmax = 2, this is Chebyshev's method.
+  - Strategy 3 (Halley-type): the corrections are accumulated, i.e. the k'th term is evaluated in the direction of the update which includes the first k-1 terms, dx_k = -J^{-1}*(F + sum_{j=2}^{k} D^jF[dx_{k-1}, ..., dx_{k-1}]/j!), k = 2, ..., Nmax. Each correction increases the order of convergence by one.
+
+The number of unknowns is a template parameter, so all vectors and matrices are stored in std::arrays on the stack, and no memory is allocated on the heap. The class is intended for small dense systems (e.g. 2-8 unknowns).
+
+@tparam n the number of equations and unknowns
+
+@see FunSystem, HiSolve
+*/
+
+template<size_t n>
+class HiSolveSystem {
+  static_assert(n > 0, "The number of unknowns must be positive");
+
+  /**
+  Type used for storing vectors
+  */
+  public:
+  typedef typename FunSystem<n>::Vec Vec;
+
+  /**
+  Type used for storing matrices
+  */
+  public:
+  typedef typename FunSystem<n>::Mat Mat;
+
+  // Internal data members
+  private:
+    double  tol_;             // Tolerance used to terminate the iterations (on the largest absolute value of the residual)
+    size_t  maxit_;           // Maximum number of iterations
+    size_t  Nmax_;            // Highest-order derivative used
+    size_t  UpdateStrategy_;  // Which update strategy to use (1, 2, or 3)
+
+  /**
+  Constructor
+
+  @param[in] tol            tolerance for terminating the iterations (on the largest absolute value of the residual)
+  @param[in] maxit          maximum number of iterations
+  @param[in] Nmax           highest-order derivative used
+  @param[in] UpdateStrategy which update strategy to use (must be 1, 2, or 3)
+  */
+  public:
+  HiSolveSystem(const double tol, const size_t maxit, const size_t Nmax, const size_t UpdateStrategy) : tol_(tol), maxit_(maxit), Nmax_(Nmax), UpdateStrategy_(UpdateStrategy) {
+    if(UpdateStrategy < 1 || UpdateStrategy > 3){
+      throw "Unknown value of UpdateStrategy. Please use 1, 2, or 3.";
+    } // End if UpdateStrategy is unknown
+  }
+
+  /**
+  Get the highest-order derivative used
+
+  @returns the highest-order derivative used
+  */
+  public:
+  size_t getNmax() const { return Nmax_; }
+
+  /**
+  Get the update strategy
+
+  @returns which update strategy is used
+  */
+  public:
+  size_t getUpdateStrategy() const { return UpdateStrategy_; }
+
+  /**
+  Solve a system of nonlinear algebraic equations
+
+  @param[in] f  function object
+  @param[in] x0 initial guess
+
+  @returns the result
+  */
+  public:
+  SystemResult<n> solve(const FunSystem<n> &f, const Vec &x0) const {
+    SystemResult<n> result;
+    Vec   &x = result.x;
+    Vec   &F = result.F;
+    Mat   J;
+    std::array<size_t, n> p;
+    Vec   dx, rhs, d;
+
+    // Evaluate the residual and the Jacobian
+    x = x0;
+    f.eval(x, F, J);
+    result.evaluations = 1;
+
+    // Iterate until termination
+    while(true){
+      // Check for termination
+      double res    = 0.0;
+      bool   Finite = true;
+      for(size_t i = 0; i != n; ++i){
+        Finite = Finite && std::isfinite(x[i]) && std::isfinite(F[i]);
+        res    = std::fabs(F[i]) > res ? std::fabs(F[i]) : res;
+      } // End for i
+
+      if(!Finite)                 { result.status = SolveNonFinite;       break; }
+      if(res < tol_)              { result.status = SolveConverged;       break; }
+      if(result.iterations == maxit_){ result.status = SolveMaxIterations; break; }
+      if(!factorize(J, p))        { result.status = SolveZeroDerivative;  break; }
+
+      // Increment the iteration counter
+      ++result.iterations;
+
+      // Newton-step
+      for(size_t i = 0; i != n; ++i){ dx[i] = -F[i]; }
+      substitute(J, p, dx);
+
+      // High-order corrections (strategy 2 evaluates all terms in the direction of the Newton-step, and strategy 3 updates the direction after each term)
+      if(UpdateStrategy_ != 1 && Nmax_ > 1){
+        const size_t K = UpdateStrategy_ == 2 ? 1 : Nmax_ - 1;
+        for(size_t l = 0; l != K; ++l){
+          // Terms of the truncated Taylor expansion (up to order Nmax for strategy 2 and up to order l+2 for strategy 3)
+          const size_t kmax = UpdateStrategy_ == 2 ? Nmax_ : l+2;
+          rhs = F;
+          double invfac = 1.0;
+          for(size_t k = 2; k <= kmax; ++k){
+            invfac /= k;
+            f.evalDirectional(x, k, dx, d);
+            ++result.directional;
+            for(size_t i = 0; i != n; ++i){ rhs[i] += invfac*d[i]; }
+          } // End for k
+
+          // Reuse the factorization of the Jacobian
+          for(size_t i = 0; i != n; ++i){ dx[i] = -rhs[i]; }
+          substitute(J, p, dx);
+        } // End for l
+      } // End if high-order corrections
+
+      // Update approximation of solution and evaluate the residual and the Jacobian
+      for(size_t i = 0; i != n; ++i){ x[i] += dx[i]; }
+      f.eval(x, F, J);
+      ++result.evaluations;
+    } // End while true
+
+    return result;
+  }
+
+  /**
+  Compute the LU factorization of a matrix (in place) using partial pivoting
+
+  @param[inout] A the matrix on entry, and the factors L (unit lower triangular, below the diagonal) and U on exit
+  @param[out]   p the row permutation
+
+  @returns false if the matrix is singular
+  */
+  public:
+  static bool factorize(Mat &A, std::array<size_t, n> &p){
+    for(size_t i = 0; i != n; ++i){ p[i] = i; }
+
+    for(size_t k = 0; k != n; ++k){
+      // Pivot
+      size_t r = k;
+      for(size_t i = k+1; i != n; ++i){
+        if(std::fabs(A[i*n + k]) > std::fabs(A[r*n + k])){ r = i; }
+      } // End for i
+      if(A[r*n + k] == 0.0 || !std::isfinite(A[r*n + k])){ return false; }
+      if(r != k){
+        for(size_t j = 0; j != n; ++j){ std::swap(A[k*n + j], A[r*n + j]); }
+        std::swap(p[k], p[r]);
+      } // End if r != k
+
+      // Eliminate
+      const double rpivot = 1.0/A[k*n + k];
+      for(size_t i = k+1; i != n; ++i){
+        const double l = A[i*n + k]*rpivot;
+        A[i*n + k] = l;
+        for(size_t j = k+1; j != n; ++j){ A[i*n + j] -= l*A[k*n + j]; }
+      } // End for i
+    } // End for k
+
+    return true;
+  }
+
+  /**
+  Solve a linear system using the LU factorization computed by factorize
+
+  @param[in]    LU the factors
+  @param[in]    p  the row permutation
+  @param[inout] b  the right-hand side on entry and the solution on exit
+  */
+  public:
+  static void substitute(const Mat &LU, const std::array<size_t, n> &p, Vec &b){
+    // Permute and solve with L
+    Vec y;
+    for(size_t i = 0; i != n; ++i){
+      double s = b[p[i]];
+      for(size_t j = 0; j != i; ++j){ s -= LU[i*n + j]*y[j]; }
+      y[i] = s;
+    } // End for i
+
+    // Solve with U
+    for(size_t i = n; i-- != 0;){
+      double s = y[i];
+      for(size_t j = i+1; j != n; ++j){ s -= LU[i*n + j]*b[j]; }
+      b[i] = s/LU[i*n + i];
+    } // End for i
+  }
+};
+
+#endif
@@ -0,0 +1,251 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_TRACE_H
+#define HI_SOLVE_TRACE_H
+
+// Standard library headers
+#include <array> // For std::array
+#include <chrono> // For steady_clock
+#include <cmath> // For fabs
+#include <cstddef> // For size_t
+#include <ostream> // For std::ostream
+#include <vector> // For std::vector
+
+/// Tracing policy which does not record anything (the default, all hooks are empty and are removed by the compiler)
+
+/**
+@see HiSolveTrace, hiSolveIterate
+*/
+
+struct HiSolveNoTrace {
+  /**
+  Whether or not the policy records anything
+  */
+  static const bool Enabled = false;
+
+  /// Hook called at the start of a solve
+  void beginSolve() {}
+
+  /// Hook called before evaluating the function (or additional derivatives)
+  void beginEval() {}
+
+  /// Hook called after evaluating the function (or additional derivatives)
+  void endEval() {}
+
+  /// Hook called after computing the update in an iteration (see HiSolveTrace::iteration)
+  template<class X, class F, class Corrections>
+  void iteration(const size_t, const X&, const F&, const X&, const size_t, const size_t, Corrections&&) {}
+};
+
+/// One iteration recorded by HiSolveTrace
+
+struct HiSolveTraceRecord {
+  /**
+  Largest number of inner-loop corrections recorded
+  */
+  static const size_t MaxCorrections = 16;
+
+  size_t  solve;        ///< The index of the solve (counted by the trace)
+  size_t  iteration;    ///< The iteration (starting from 1)
+  double  x;            ///< The approximate solution before the update
+  double  f;            ///< The function value at x
+  double  dx;           ///< The update
+  size_t  order;        ///< The highest order of the derivatives evaluated at x
+  size_t  terms;        ///< The number of terms used by the update strategy
+  double  start;        ///< The time (in seconds since the trace was created) at which the function was evaluated at x
+  double  duration;     ///< The time (in seconds) spent on the iteration, i.e. evaluating the function and computing the update
+  double  evalTime;     ///< The time (in seconds) spent evaluating the function and its derivatives at x
+  size_t  corrections;  ///< The number of inner-loop corrections recorded (at most MaxCorrections)
+  std::array<double, MaxCorrections> correction; ///< The update computed using 1, 2, ... terms, i.e. the successive corrections of the Newton-step by the update strategy
+};
+
+/// Tracing policy recording each iteration in a preallocated ring buffer
+
+/**
+The trace is passed to HiSolve::solve (or to hiSolveIterate). For each iteration, it records the approximate solution, the function value, the update, the order of the derivatives, the corrections computed in the inner loop of the update strategy, and the time spent evaluating the function. The buffer is allocated when the trace is created, and the oldest records are overwritten once it is full, i.e. recording never allocates memory. A trace must not be shared by several threads.
+
+The records can be exported to the Chrome trace event format (which can be viewed in chrome://tracing or Perfetto), and the order of convergence can be estimated from the updates.
+
+@see HiSolveNoTrace, HiSolve
+*/
+
+class HiSolveTrace {
+  /**
+  Whether or not the policy records anything
+  */
+  public:
+  static const bool Enabled = true;
+
+  // Internal data members
+  private:
+    typedef std::chrono::steady_clock Clock;
+    std::vector<HiSolveTraceRecord> records_; // Ring buffer
+    size_t            recorded_;  // Number of records since the trace was cleared
+    size_t            solves_;    // Number of solves started
+    Clock::time_point origin_;    // Time at which the trace was created
+    Clock::time_point evalStart_; // Time at which the current evaluation started
+    double            iterStart_; // Time at which the first evaluation at the current approximate solution started (negative if none)
+    double            evalTime_;  // Time spent evaluating the function at the current approximate solution
+
+  /**
+  Constructor allocating the ring buffer
+
+  @param[in] capacity the number of iterations which can be recorded before the oldest records are overwritten (must be positive)
+  */
+  public:
+  HiSolveTrace(const size_t capacity = 1024) : records_(capacity), recorded_(0), solves_(0), origin_(Clock::now()), iterStart_(-1.0), evalTime_(0.0) {
+    if(capacity == 0){
+      throw "The capacity of the trace must be positive.";
+    } // End if capacity is zero
+  }
+
+  /**
+  Get the number of iterations which can be recorded
+
+  @returns the capacity of the ring buffer
+  */
+  public:
+  size_t capacity() const { return records_.size(); }
+
+  /**
+  Get the number of records held
+
+  @returns the number of records (at most the capacity)
+  */
+  public:
+  size_t size() const { return recorded_ < records_.size() ? recorded_ : records_.size(); }
+
+  /**
+  Get the number of records which have been overwritten
+
+  @returns the number of records lost because the buffer was full
+  */
+  public:
+  size_t dropped() const { return recorded_ - size(); }
+
+  /**
+  Get a record
+
+  @param[in] i the index of the record (0 is the oldest record held)
+
+  @returns the record
+  */
+  public:
+  const HiSolveTraceRecord &operator[](const size_t i) const { return records_[(recorded_ - size() + i)%records_.size()]; }
+
+  /**
+  Remove all records (the ring buffer is kept)
+  */
+  public:
+  void clear(){ recorded_ = 0; solves_ = 0; }
+
+  /**
+  Hook called at the start of a solve
+  */
+  public:
+  void beginSolve(){
+    ++solves_;
+    iterStart_ = -1.0;
+    evalTime_  = 0.0;
+  }
+
+  /**
+  Hook called before evaluating the function (or additional derivatives)
+  */
+  public:
+  void beginEval(){
+    evalStart_ = Clock::now();
+    if(iterStart_ < 0.0){ iterStart_ = seconds(evalStart_); }
+  }
+
+  /**
+  Hook called after evaluating the function (or additional derivatives)
+  */
+  public:
+  void endEval(){ evalTime_ += std::chrono::duration<double>(Clock::now() - evalStart_).count(); }
+
+  /**
+  Hook called after computing the update in an iteration
+
+  @param[in] it          the iteration
+  @param[in] x           the approximate solution before the update
+  @param[in] f           the function value at x
+  @param[in] dx          the update
+  @param[in] order       the highest order of the derivatives evaluated at x
+  @param[in] N           the number of terms used by the update strategy
+  @param[in] corrections callable computing the update using a given number of terms (only called for recording the inner-loop corrections)
+  */
+  public:
+  template<class X, class F, class Corrections>
+  void iteration(const size_t it, const X &x, const F &f, const X &dx, const size_t order, const size_t N, Corrections &&corrections){
+    // The end of the iteration (the corrections are recomputed below, which must not be attributed to the iteration)
+    const double now = seconds(Clock::now());
+
+    HiSolveTraceRecord &r = records_[recorded_%records_.size()];
+    r.solve       = solves_;
+    r.iteration   = it;
+    r.x           = static_cast<double>(x);
+    r.f           = static_cast<double>(f);
+    r.dx          = static_cast<double>(dx);
+    r.order       = order;
+    r.terms       = N;
+    r.corrections = N < HiSolveTraceRecord::MaxCorrections ? N : HiSolveTraceRecord::MaxCorrections;
+    for(size_t k = 0; k != r.corrections; ++k){
+      r.correction[k] = static_cast<double>(corrections(k+1));
+    } // End for k
+    r.start       = iterStart_ < 0.0 ? now : iterStart_;
+    r.duration    = now - r.start;
+    r.evalTime    = evalTime_;
+    ++recorded_;
+
+    // The next evaluation is at a new approximate solution
+    iterStart_ = -1.0;
+    evalTime_  = 0.0;
+  }
+
+  /**
+  Estimate the order of convergence of the most recent solve held, i.e. log(|dx_{k+1}|/|dx_k|)/log(|dx_k|/|dx_{k-1}|) for the last three updates which are not dominated by rounding errors
+
+  @returns the estimated order of convergence (NaN if fewer than three suitable updates have been recorded)
+  */
+  public:
+  double orderOfConvergence() const;
+
+  /**
+  Write the records in the Chrome trace event format (JSON)
+
+  Each iteration is a complete event (with the approximate solution, the function value, the update, the order, and the corrections as arguments) containing an event for the evaluation of the function. Each solve is shown as a separate thread, and the residual is shown as a counter (log10 of the absolute value).
+
+  @param[in] out the stream written to
+  */
+  public:
+  void writeChromeTrace(std::ostream &out) const;
+
+  // Convert a time point to seconds since the trace was created
+  private:
+  double seconds(const Clock::time_point t) const { return std::chrono::duration<double>(t - origin_).count(); }
+};
+
+#endif
@@ -0,0 +1,173 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_TUNER_H
+#define HI_SOLVE_TUNER_H
+
+// Standard library headers
+#include <cstddef> // For size_t
+#include <string> // For std::string
+#include <utility> // For std::pair
+#include <vector> // For std::vector
+
+// Solver and abstract function base class
+#include <hi-solve.h>
+
+/// A configuration of HiSolve together with its measured performance
+
+struct HiSolveTuning {
+  size_t  Nmax            = 1;    ///< The highest-order derivative used
+  size_t  UpdateStrategy  = 1;    ///< The update strategy (1, 2, 3, or 4)
+  bool    UseMaxOrder     = true; ///< Whether or not the maximum-order variant is used
+  double  ns              = 0.0;  ///< Wall time per solve (in nanoseconds)
+  double  evaluations     = 0.0;  ///< Function evaluations per solve
+  double  failures        = 0.0;  ///< Fraction of the solves which did not converge
+};
+
+/// An auto-tuner choosing the update strategy, Nmax, and variant of HiSolve for a family of functions
+
+/**
+The tuner solves a sample of representative problems (function objects and initial guesses) using every combination of the candidate values of Nmax, the four update strategies, and the maximum-order and variable-order variants. For each configuration, it measures the wall time, the number of function evaluations, and the fraction of the solves which failed. The fastest configuration whose failure rate does not exceed the largest acceptable failure rate is selected (if no configuration is reliable enough, the one with the smallest failure rate is selected).
+
+The selected configurations are stored in a small text file (the tuning cache) with one line per family of functions, where the family is identified by a user-supplied string (without whitespace), e.g. "peng-robinson" or "kepler". Production runs load the configuration at startup using tune, which only calibrates if the family is not in the cache.
+
+@see HiSolve, HiSolveTuning
+*/
+
+class HiSolveTuner {
+  /**
+  Type of a sample problem, i.e. a function object and an initial guess
+  */
+  public:
+  typedef std::pair<const Fun*, double> Problem;
+
+  // Internal data members
+  private:
+    double  tol_;             // Tolerance used by the solvers
+    size_t  maxit_;           // Maximum number of iterations used by the solvers
+    size_t  repetitions_;     // Number of times the sample is solved when measuring the wall time
+    double  MaxFailureRate_;  // Largest acceptable failure rate
+    std::vector<size_t> NmaxCandidates_; // Candidate values of Nmax
+
+  /**
+  Constructor
+
+  @param[in] tol            tolerance used by the solvers
+  @param[in] maxit          maximum number of iterations used by the solvers
+  @param[in] repetitions    number of times the sample is solved when measuring the wall time
+  @param[in] MaxFailureRate largest acceptable fraction of failed solves
+  */
+  public:
+  HiSolveTuner(const double tol, const size_t maxit, const size_t repetitions = 10, const double MaxFailureRate = 0.0) :
+    tol_(tol), maxit_(maxit), repetitions_(repetitions > 0 ? repetitions : 1), MaxFailureRate_(MaxFailureRate), NmaxCandidates_({1, 2, 3, 4, 6, 8}) {}
+
+  /**
+  Set the candidate values of Nmax
+
+  @param[in] NmaxCandidates the values of Nmax which are tried (must not be empty)
+  */
+  public:
+  void setNmaxCandidates(const std::vector<size_t> &NmaxCandidates){
+    if(NmaxCandidates.empty()){
+      throw "There must be at least one candidate value of Nmax.";
+    } // End if NmaxCandidates is empty
+
+    NmaxCandidates_ = NmaxCandidates;
+  }
+
+  /**
+  Get the candidate values of Nmax
+
+  @returns the values of Nmax which are tried
+  */
+  public:
+  const std::vector<size_t> &getNmaxCandidates() const { return NmaxCandidates_; }
+
+  /**
+  Measure the performance of one configuration on a sample of problems
+
+  @param[in] tuning   the configuration (the measurements are ignored)
+  @param[in] problems the sample of problems
+
+  @returns the configuration together with the measurements
+  */
+  public:
+  HiSolveTuning measure(const HiSolveTuning &tuning, const std::vector<Problem> &problems) const;
+
+  /**
+  Calibrate, i.e. measure all configurations on a sample of problems and select the fastest reliable one
+
+  @param[in] problems the sample of problems (must not be empty)
+
+  @returns the selected configuration
+  */
+  public:
+  HiSolveTuning calibrate(const std::vector<Problem> &problems) const;
+
+  /**
+  Create a solver using a configuration (and the tolerance and maximum number of iterations of the tuner)
+
+  @param[in] tuning the configuration
+
+  @returns the solver
+  */
+  public:
+  HiSolve solver(const HiSolveTuning &tuning) const { return HiSolve(tol_, maxit_, tuning.Nmax, tuning.UseMaxOrder, tuning.UpdateStrategy); }
+
+  /**
+  Load the configuration of a family from the tuning cache, or calibrate and store it in the cache if it is not there
+
+  @param[in] cache    the name of the tuning cache file (created if it does not exist)
+  @param[in] family   the identifier of the family of functions
+  @param[in] problems the sample of problems (only used if the family is not in the cache)
+
+  @returns the solver using the configuration
+  */
+  public:
+  HiSolve tune(const std::string &cache, const std::string &family, const std::vector<Problem> &problems) const;
+
+  /**
+  Load the configuration of a family from a tuning cache
+
+  @param[in]  cache  the name of the tuning cache file
+  @param[in]  family the identifier of the family of functions
+  @param[out] tuning the configuration (unchanged if the family is not in the cache)
+
+  @returns true if the family is in the cache
+  */
+  public:
+  static bool load(const std::string &cache, const std::string &family, HiSolveTuning &tuning);
+
+  /**
+  Store the configuration of a family in a tuning cache (replacing a previous configuration of the family)
+
+  @param[in] cache  the name of the tuning cache file (created if it does not exist)
+  @param[in] family the identifier of the family of functions (must be nonempty and must not contain whitespace)
+  @param[in] tuning the configuration
+  */
+  public:
+  static void save(const std::string &cache, const std::string &family, const HiSolveTuning &tuning);
+};
+
+#endif
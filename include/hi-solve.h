@@ -28,17 +28,117 @@ SOFTWARE.
 // Standard library headers
 #include <vector> // For std::vector
 #include <cmath> // For pow
-#include <algorithm> // For min
+#include <algorithm> // For min and copy
+#include <type_traits> // For std::enable_if and std::is_base_of
 
 // Abstract function base class
 #include <fun.h>
 
+// Result of solving an equation
+#include <solve-result.h>
+
+// Compile-time specialized engine
+#include <hi-solve-engine.h>
+
+// Double-double arithmetic (used by the mixed-precision variant)
+#include <double-double.h>
+
+/// Caller-owned workspace used by HiSolve
+
+/**
+The workspace holds the function value and derivatives used while solving an equation, followed by the scratch values of update strategy 4 (see hiSolvePadeUpdate). It is separate from the (immutable) configuration in HiSolve, such that one HiSolve object can be shared by several threads, each of which owns a workspace. The storage for up to InlineSize function values and derivatives (and the corresponding scratch values) is part of the object itself, so no memory is allocated on the heap unless Nmax + 2 exceeds InlineSize. Otherwise, memory is only allocated the first time it is needed.
+
+@see HiSolve
+*/
+
+class HiSolveWorkspace {
+  /**
+  Number of values stored inside the workspace object itself
+  */
+  public:
+  static const size_t InlineSize = 32;
+
+  // The update of strategy 4 does not allocate memory either unless Nmax + 2 exceeds InlineSize (when it is computed without a workspace)
+  static_assert(2*(InlineSize - 1) <= HiSolvePadeInlineSize, "The workspace of hiSolvePade is too small");
+
+  /**
+  Total number of values (i.e. including the scratch values of update strategy 4) stored inside the workspace object itself
+  */
+  public:
+  static const size_t InlineValues = 3*InlineSize - 2;
+
+  // Internal data members
+  private:
+    double              inline_[InlineValues];  // Storage used for up to InlineValues values
+    std::vector<double> heap_;                  // Storage used for more than InlineValues values
+
+  /**
+  Constructor
+
+  @param[in] Nmax highest-order derivative used (memory is reserved if necessary)
+  */
+  public:
+  HiSolveWorkspace(const size_t Nmax = 0) : inline_() { reserve(Nmax); }
+
+  /**
+  Reserve room for the function value and derivatives up to order Nmax+1 and for the 2*(Nmax+1) scratch values of update strategy 4 (only allocates memory if Nmax + 2 exceeds InlineSize and the workspace is too small)
+
+  @param[in] Nmax highest-order derivative used
+  */
+  public:
+  void reserve(const size_t Nmax){ reserveValues(3*Nmax+4); }
+
+  /**
+  Reserve room for n values (only allocates memory if n exceeds InlineValues and the workspace is too small)
+
+  This is used by solvers which need a different layout of the workspace (see HiSolve::derivativeFreeWorkspaceSize).
+
+  @param[in] n number of values
+  */
+  public:
+  void reserveValues(const size_t n){
+    if(n > InlineValues && heap_.size() < n){ heap_.resize(n); }
+  }
+
+  /**
+  Get a view of n values
+
+  @param[in] n number of values (the workspace must have been reserved for them)
+
+  @returns a view of n values
+  */
+  public:
+  DfSpan values(const size_t n){ return DfSpan(n <= InlineValues ? inline_ : heap_.data(), n); }
+
+  /**
+  Get a view of the function value and derivatives
+
+  @param[in] Nmax highest-order derivative used (the workspace must have been reserved for it)
+
+  @returns a view of Nmax+2 values
+  */
+  public:
+  DfSpan df(const size_t Nmax){ return DfSpan(values(3*Nmax+4).data(), Nmax+2); }
+
+  /**
+  Get the scratch values of update strategy 4 (see hiSolvePadeUpdate), which follow the function value and derivatives
+
+  @param[in] Nmax highest-order derivative used (the workspace must have been reserved for it)
+
+  @returns a pointer to 2*(Nmax+1) values
+  */
+  public:
+  double *work(const size_t Nmax){ return values(3*Nmax+4).data() + Nmax+2; }
+};
+
 /// A class for solving scalar nonlinear algebraic equations using high-order methods
 
 /**
 This class provides functionality for approximating the solution to scalar-valued nonlinear algebraic equations by using a high-order numerical method, i.e. a method which exploits the information from high-order derivative of the algebraic function.
 
-You need to provide a function object which allows the return of these high-order derivatives; this class does not compute them (e.g. using finite-difference approximations or automatic differentiation techniques).
+An object of this class only holds the (immutable during a solve) configuration of the method. The function value and derivatives are stored in a HiSolveWorkspace, so the solve functions are const and reentrant, i.e. one object can be used by several threads at once, as long as each thread uses its own workspace.
+
+You need to provide a function object which allows the return of these high-order derivatives; this class does not compute them (e.g. using finite-difference approximations or automatic differentiation techniques). However, TaylorFun can be used to compute them automatically from a generic callable using truncated Taylor series (see taylor.h).
 */
 
 class HiSolve {
@@ -48,8 +148,13 @@ class HiSolve {
     size_t  maxit_;           // Maximum number of iterations
     size_t  Nmax_;            // Maximum order used
     bool    UseMaxOrder_;     // Whether or not to use the maximum-order variant of the algorithm
-    std::vector<double> df;   // Function value and derivatives
-    double (HiSolve::*updateStrategy)(const size_t) const;  // Which update strategy to use (1, 2, or 3)
+    size_t  UpdateStrategy_;  // Which update strategy to use (1, 2, 3, or 4)
+    bool    AdaptiveOrder_;   // Whether or not to choose the order in each iteration using the cost model
+    std::vector<double> OrderCosts_; // Cost of evaluating the function value and derivatives up to each order (empty for the default cost model)
+    double  MixedSwitchTol_;  // Relative reduction of the residual after which the mixed-precision variant switches from float to double
+    bool    MixedPolish_;     // Whether or not the mixed-precision variant polishes the solution in double-double precision
+    double (HiSolve::*updateStrategy)(const double*, const size_t, double*) const;  // Which update strategy to use (1, 2, 3, or 4)
+    void (HiSolve::*updateStrategyBatch)(const size_t, const size_t, const double*, double*, double*) const; // Batched version of the update strategy
 
   /**
   Constructor with default values for tolerance (1e-6), maximum number of iterations (20), and variant of the algorithm (maximum-order variant).
@@ -57,7 +162,7 @@ class HiSolve {
   @param[in] Nmax highest-order derivative used
   */
   public:
-  HiSolve(const size_t Nmax) : tol_(1.0e-6), maxit_(20), Nmax_(Nmax), UseMaxOrder_(true), df(Nmax) { setUpdateStrategy(1); }
+  HiSolve(const size_t Nmax) : tol_(1.0e-6), maxit_(20), Nmax_(Nmax), UseMaxOrder_(true), AdaptiveOrder_(false), MixedSwitchTol_(1.0e-4), MixedPolish_(false) { setUpdateStrategy(1); }
 
   /**
   Constructor with user-specified tolerance, maximum number of iterations, and variant of the algorithm.
@@ -66,10 +171,10 @@ class HiSolve {
   @param[in] maxit        maximum number of iterations
   @param[in] Nmax         highest-order derivative used
   @param[in] UseMaxOrder  whether or not to use the maximum-order variant of the algorithm
-  @param[in] UpdateStrategy which update strategy to use (must be 1, 2, or 3)
+  @param[in] UpdateStrategy which update strategy to use (must be 1, 2, 3, or 4)
   */
   public:
-  HiSolve(const double tol, const size_t maxit, const size_t Nmax, const bool UseMaxOrder, const size_t UpdateStrategy) : tol_(tol), maxit_(maxit), Nmax_(Nmax), UseMaxOrder_(UseMaxOrder), df(Nmax) { setUpdateStrategy(UpdateStrategy); }
+  HiSolve(const double tol, const size_t maxit, const size_t Nmax, const bool UseMaxOrder, const size_t UpdateStrategy) : tol_(tol), maxit_(maxit), Nmax_(Nmax), UseMaxOrder_(UseMaxOrder), AdaptiveOrder_(false), MixedSwitchTol_(1.0e-4), MixedPolish_(false) { setUpdateStrategy(UpdateStrategy); }
 
   /**
   Set the tolerance for terminating the iterations
@@ -136,56 +241,870 @@ class HiSolve {
   bool getUseMaxOrder() const { return UseMaxOrder_; }
 
   /**
-  Set the update strategy (1, 2, or 3)
+  Set the update strategy (1, 2, 3, or 4)
 
-  @param UpdateStrategy the update strategy number (1, 2, or 3)
+  Strategies 1, 2, and 3 approximate the powers of the update in the truncated Taylor expansion of the function (strategy 1 is Newton's method). Strategy 4 uses the root of a Pade approximant of the truncated Taylor expansion (Householder's method of order N+1, see hiSolvePadeUpdate), i.e. it exploits all N derivatives in each iteration.
+
+  @param UpdateStrategy the update strategy number (1, 2, 3, or 4)
   */
   public:
   void setUpdateStrategy(const size_t UpdateStrategy){
-    if(UpdateStrategy == 0 || UpdateStrategy > 3){
-      throw "Unknown value of UpdateStrategy. Please use 1, 2, or 3.";
-    } // End if UpdateStrategy != 1, 2, or 3
+    if(UpdateStrategy == 0 || UpdateStrategy > 4){
+      throw "Unknown value of UpdateStrategy. Please use 1, 2, 3, or 4.";
+    } // End if UpdateStrategy != 1, 2, 3, or 4
 
     // Set the update strategy
+    UpdateStrategy_ = UpdateStrategy;
     switch(UpdateStrategy){
-      case 1: updateStrategy = &HiSolve::updateStrategy1; break;
-      case 2: updateStrategy = &HiSolve::updateStrategy2; break;
-      case 3: updateStrategy = &HiSolve::updateStrategy3; break;
+      case 1: updateStrategy = &HiSolve::updateStrategy1; updateStrategyBatch = &HiSolve::updateStrategyBatch1; break;
+      case 2: updateStrategy = &HiSolve::updateStrategy2; updateStrategyBatch = &HiSolve::updateStrategyBatch2; break;
+      case 3: updateStrategy = &HiSolve::updateStrategy3; updateStrategyBatch = &HiSolve::updateStrategyBatch3; break;
+      case 4: updateStrategy = &HiSolve::updateStrategy4; updateStrategyBatch = &HiSolve::updateStrategyBatch4; break;
     } // End switch UpdateStrategy
   }
 
+  /**
+  Get the update strategy (1, 2, 3, or 4)
+
+  @returns the update strategy number
+  */
+  public:
+  size_t getUpdateStrategy() const { return UpdateStrategy_; }
+
+  /**
+  Set whether or not to use the adaptive-order variant
+
+  In the adaptive-order variant, the order used in the next iteration is chosen such that it maximizes the efficiency index, i.e. the number of digits gained per unit cost, predicted from the current step size, the nominal order of convergence of the update strategy (which is corrected by the observed order of convergence), and the cost model (see setOrderCosts). Far from the solution (where the step size is not small), the order is chosen as in the maximum-order or variable-order variant (see setUseMaxOrder). Furthermore, the update strategies stop adding terms once the correction is below the tolerance. The compile-time specialized engine is not used in the adaptive-order variant, and solveBatch does not use it.
+
+  @param[in] AdaptiveOrder if true, the adaptive-order variant of the algorithm is used
+  */
+  public:
+  void setAdaptiveOrder(const bool AdaptiveOrder){ AdaptiveOrder_ = AdaptiveOrder; }
+
+  /**
+  Get whether or not the adaptive-order variant is used
+
+  @returns whether or not the adaptive-order variant of the algorithm is used
+  */
+  public:
+  bool getAdaptiveOrder() const { return AdaptiveOrder_; }
+
+  /**
+  Set the cost model used in the adaptive-order variant
+
+  @param[in] OrderCosts the cost of evaluating the function value and derivatives up to (and including) order 0, 1, ... (the cost of higher orders is extrapolated linearly). If empty, each derivative costs the same as the function value. The costs can be measured using measureOrderCosts.
+  */
+  public:
+  void setOrderCosts(const std::vector<double> &OrderCosts){
+    for(const double c : OrderCosts){
+      if(!(c > 0.0)){
+        throw "The costs in the cost model must be positive.";
+      } // End if c is not positive
+    } // End for c
+
+    OrderCosts_ = OrderCosts;
+  }
+
+  /**
+  Get the cost model used in the adaptive-order variant
+
+  @returns the cost of evaluating the function value and derivatives up to order 0, 1, ... (empty for the default cost model)
+  */
+  public:
+  const std::vector<double> &getOrderCosts() const { return OrderCosts_; }
+
+  /**
+  Set when the mixed-precision variant switches from float to double (see solveMixed)
+
+  @param[in] MixedSwitchTol the iterations in float are terminated once the absolute value of the function has been reduced by this factor (must be positive and less than one)
+  */
+  public:
+  void setMixedSwitchTol(const double MixedSwitchTol){
+    if(!(MixedSwitchTol > 0.0 && MixedSwitchTol < 1.0)){
+      throw "The switching tolerance must be between zero and one.";
+    } // End if MixedSwitchTol is out of range
+
+    MixedSwitchTol_ = MixedSwitchTol;
+  }
+
+  /**
+  Get when the mixed-precision variant switches from float to double
+
+  @returns the factor by which the absolute value of the function is reduced in float
+  */
+  public:
+  double getMixedSwitchTol() const { return MixedSwitchTol_; }
+
+  /**
+  Set whether or not the mixed-precision variant polishes the solution in double-double precision (see solveMixed)
+
+  @param[in] MixedPolish if true, the final iterations are carried out in double-double precision
+  */
+  public:
+  void setMixedPolish(const bool MixedPolish){ MixedPolish_ = MixedPolish; }
+
+  /**
+  Get whether or not the mixed-precision variant polishes the solution in double-double precision
+
+  @returns whether or not the solution is polished in double-double precision
+  */
+  public:
+  bool getMixedPolish() const { return MixedPolish_; }
+
+  /**
+  Measure the cost model of a function object by timing its evaluation
+
+  @param[in] f           function object
+  @param[in] x           the value at which the function is evaluated
+  @param[in] Nmax        highest-order derivative
+  @param[in] repetitions number of evaluations timed for each order
+
+  @returns the time in seconds of evaluating the function value and derivatives up to order 0, 1, ..., Nmax
+  */
+  public:
+  static std::vector<double> measureOrderCosts(const Fun &f, const double x, const size_t Nmax, const size_t repetitions = 100);
+
+  /**
+  Largest value of Nmax for which solve uses a compile-time specialized engine (see HiSolveEngine)
+  */
+  public:
+  static const size_t NmaxSpecialized = 8;
+
+  /**
+  Solve a set of nonlinear algebraic equations using a caller-owned workspace
+
+  If Nmax is at most NmaxSpecialized, the equation is solved using a pre-instantiated specialization of HiSolveEngine, i.e. with fully unrolled update strategies. No memory is allocated on the heap (except if the workspace must grow, see HiSolveWorkspace::reserve).
+
+  @param[in]    f  function object
+  @param[in]    x0 initial guess
+  @param[inout] ws workspace
+
+  @returns the result, i.e. the approximate solution, the function value and derivatives at the approximate solution (a view of the workspace), the number of iterations and function evaluations, and the reason for terminating the iterations
+  */
+  public:
+  SolveResult solve(const Fun &f, const double x0, HiSolveWorkspace &ws) const;
+
   /**
   Solve a set of nonlinear algebraic equations
 
+  A workspace is created on the stack (no memory is allocated on the heap unless Nmax + 2 exceeds HiSolveWorkspace::InlineSize).
+
+  @param[in] f  function object
+  @param[in] x0 initial guess
+
+  @returns the approximate solution
+  */
+  public:
+  double solve(const Fun &f, const double x0) const {
+    HiSolveWorkspace ws(Nmax_);
+    return solve(f, x0, ws).x;
+  }
+
+  /**
+  Solve a set of nonlinear algebraic equations and record each iteration in a trace
+
+  The iterations are dispatched exactly like those of solve(const Fun&, const double, HiSolveWorkspace&) const (i.e. to the adaptive-order variant, the compile-time specialized engine or the update strategy chosen at run time), i.e. the results are the same. The solve functions without a trace do not record anything and do not measure any times.
+
+  @param[in]    f     function object
+  @param[in]    x0    initial guess
+  @param[inout] ws    workspace
+  @param[inout] trace the trace (see HiSolveTrace)
+
+  @returns the result
+  */
+  public:
+  SolveResult solve(const Fun &f, const double x0, HiSolveWorkspace &ws, HiSolveTrace &trace) const;
+
+  /**
+  Solve a nonlinear algebraic equation represented by a generic callable (e.g. a lambda or a functor) using a caller-owned workspace
+
+  The callable is invoked as f(x, N, df), where df points to an array which holds at least N+2 values, and it must store the function value and up to (and including) the N'th order derivative in df[0], ..., df[N]. As opposed to the function objects deriving from Fun, the callable is not called through a virtual function, and it is inlined into the compile-time specialized engine (see HiSolveEngine) whenever Nmax is at most NmaxSpecialized.
+
+  @param[in]    f  callable
+  @param[in]    x0 initial guess
+  @param[inout] ws workspace
+
+  @returns the result (see solve(const Fun&, const double, HiSolveWorkspace&) const)
+  */
+  public:
+  template<class F, typename std::enable_if<!std::is_base_of<Fun, typename std::decay<F>::type>::value, int>::type = 0>
+  SolveResult solve(F &&f, const double x0, HiSolveWorkspace &ws) const {
+    // Function value and derivatives
+    ws.reserve(Nmax_);
+    const DfSpan df = ws.df(Nmax_);
+
+    // Iterate using the adaptive-order variant
+    const auto eval = [&f](const double x, const size_t N, const DfSpan &df){ f(x, N, df.data()); };
+    const auto more = [](const double, const size_t, const size_t, const DfSpan&){};
+    if(AdaptiveOrder_){ return iterateAdaptive(eval, more, false, df, ws.work(Nmax_), x0); }
+
+    // Use a compile-time specialized engine if possible
+    if(Nmax_ > 0 && Nmax_ <= NmaxSpecialized){
+      typedef typename std::remove_reference<F>::type Callable;
+      return HiSolveDispatch<HiSolveCallable<Callable>::template Entry, NmaxSpecialized>::lookup(Nmax_, UpdateStrategy_, UseMaxOrder_)(f, df, x0, tol_, maxit_);
+    } // End if Nmax_ <= NmaxSpecialized
+
+    // Iterate using the update strategy chosen at run time
+    return iterate(eval, more, false, df, ws.work(Nmax_), x0);
+  }
+
+  /**
+  Solve a nonlinear algebraic equation represented by a generic callable (e.g. a lambda or a functor)
+
+  A workspace is created on the stack (see solve(F&&, const double, HiSolveWorkspace&) const).
+
+  @param[in] f  callable
+  @param[in] x0 initial guess
+
+  @returns the approximate solution
+  */
+  public:
+  template<class F, typename std::enable_if<!std::is_base_of<Fun, typename std::decay<F>::type>::value, int>::type = 0>
+  double solve(F &&f, const double x0) const {
+    HiSolveWorkspace ws(Nmax_);
+    return solve(f, x0, ws).x;
+  }
+
+  /**
+  Solve a nonlinear algebraic equation represented by a generic callable using the mixed-precision variant of the algorithm
+
+  The callable must be generic in the scalar type, i.e. it is invoked as f(x, N, df), where x is a float, a double, or a DoubleDouble and df points to an array of the same type (see solve(F&&, const double, HiSolveWorkspace&) const), e.g. a lambda with auto parameters or a functor with a templated call operator (see PolyFun::evalGeneric). The early iterations are carried out in float until the absolute value of the function has been reduced by the factor getMixedSwitchTol() (or is below the tolerance). If they do not converge (e.g. because the function overflows in float, or because the residual cannot be reduced sufficiently within getMaxIt() iterations), the initial guess is used instead. The remaining iterations are carried out in double. If setMixedPolish(true) has been called, the iterations in double are terminated once the absolute value of the function has been reduced by the factor getMixedSwitchTol()^2, and the final iterations are carried out in double-double precision, such that tolerances close to (or below) machine precision can be reached. The leading and trailing parts of the polished solution are returned in SolveResult::x and SolveResult::xLow.
+
+  The iterations in float are scalar, i.e. they are typically not faster than those in double (see solveBatchMixed for float SIMD lanes).
+
+  Each stage uses at most getMaxIt() iterations, and the numbers of iterations and function evaluations in the result are summed over the stages. The status is that of the last stage. SolveResult::df is only a view of the workspace if the last stage is carried out in double.
+
+  @param[in]    f  callable
+  @param[in]    x0 initial guess
+  @param[inout] ws workspace
+
+  @returns the result
+  */
+  public:
+  template<class F>
+  SolveResult solveMixed(F &&f, const double x0, HiSolveWorkspace &ws) const {
+    // Function value and derivatives at the initial guess in float (reused by the first iteration in float)
+    const size_t Order0 = Order(N(0));
+    float inline_[HiSolveWorkspace::InlineSize];
+    std::vector<float> heap;
+    if(Order0 + 1 > HiSolveWorkspace::InlineSize){ heap.resize(Order0 + 1); }
+    float *f0 = heap.empty() ? inline_ : heap.data();
+    float xf  = static_cast<float>(x0);
+    f(xf, Order0, f0);
+    const double r0 = std::fabs(static_cast<double>(f0[0]));
+
+    // Iterate in float until the residual has been reduced sufficiently (use the initial guess if the iterations fail)
+    SolveResult result = iterateScalar(f, xf, std::max(tol_, MixedSwitchTol_*r0), f0);
+    const size_t evaluations  = result.evaluations;
+    const size_t iterations   = result.iterations;
+    const size_t order        = result.order;
+    const double x1           = result.converged() ? result.x : x0;
+
+    if(!MixedPolish_){
+      // Iterate in double until convergence
+      result = solve(f, x1, ws);
+    }
+    else{
+      // Iterate in double until the residual has been reduced sufficiently
+      double xd = x1;
+      result = iterateScalar(f, xd, std::max(tol_, MixedSwitchTol_*MixedSwitchTol_*r0));
+
+      // Polish in double-double precision
+      DoubleDouble xdd = result.status == SolveNonFinite ? x1 : xd;
+      const SolveResult polish = iterateScalar(f, xdd, tol_);
+      result.iterations  += polish.iterations;
+      result.evaluations += polish.evaluations;
+      result.order        = std::max(result.order, polish.order);
+      result.status       = polish.status;
+      result.x            = xdd.hi;
+      result.xLow         = xdd.lo;
+      result.f            = polish.f;
+      result.df           = DfSpan(nullptr, 0);
+    } // End if !MixedPolish_
+
+    // Include the iterations and function evaluations in float
+    result.iterations  += iterations;
+    result.evaluations += evaluations;
+    result.order        = std::max(result.order, order);
+
+    return result;
+  }
+
+  /**
+  Solve a nonlinear algebraic equation represented by a generic callable using the mixed-precision variant of the algorithm
+
+  A workspace is created on the stack (see solveMixed(F&&, const double, HiSolveWorkspace&) const).
+
+  @param[in] f  callable
+  @param[in] x0 initial guess
+
+  @returns the approximate solution (the leading part if it was polished in double-double precision)
+  */
+  public:
+  template<class F>
+  double solveMixed(F &&f, const double x0) const {
+    HiSolveWorkspace ws(Nmax_);
+    return solveMixed(f, x0, ws).x;
+  }
+
+  /**
+  Solve a batch of n independent nonlinear algebraic equations represented by a generic batch callable using the mixed-precision variant of the algorithm
+
+  The callable must be generic in the scalar type, i.e. it is invoked as f(x, n, N, dfSoA), where x points to n floats or doubles and dfSoA points to (N+1)*n values of the same type in SoA layout (see Fun::evalBatch), e.g. a lambda with auto parameters (see PolyFun::evalBatchGeneric). The lanes are iterated in float, i.e. with twice as many lanes per SIMD instruction as in double, until the absolute value of the function has been reduced by the factor getMixedSwitchTol() (or is below the tolerance). Lanes whose iterations in float do not converge start from the initial guess in double. The remaining iterations are carried out in double like in solveBatch (but without the staged protocol). The solutions are not polished in double-double precision (see setMixedPolish).
+
+  @param[in]  f         callable
+  @param[in]  n         number of equations
+  @param[in]  x0        initial guesses (n values)
+  @param[out] x         approximate solutions (n values)
+  @param[out] Converged whether or not each of the n equations converged (ignored if null)
+
+  @returns the number of equations which converged
+  */
+  public:
+  template<class F>
+  size_t solveBatchMixed(F &&f, const size_t n, const double *x0, double *x, bool *Converged = nullptr) const {
+    // Approximate solutions in float and per-lane convergence flags
+    std::vector<float>         xf(n);
+    std::vector<unsigned char> ok(n);
+    for(size_t j = 0; j != n; ++j){
+      xf[j] = static_cast<float>(x0[j]);
+    } // End for j
+
+    // Iterate in float until the residuals have been reduced sufficiently (use the initial guesses of the lanes which do not converge)
+    iterateBatch(f, n, xf.data(), MixedSwitchTol_, ok.data());
+    for(size_t j = 0; j != n; ++j){
+      x[j] = ok[j] ? static_cast<double>(xf[j]) : x0[j];
+    } // End for j
+
+    // Iterate in double until convergence
+    const size_t nConverged = iterateBatch(f, n, x, 0.0, ok.data());
+    if(Converged){
+      for(size_t j = 0; j != n; ++j){
+        Converged[j] = ok[j];
+      } // End for j
+    } // End if Converged
+
+    return nConverged;
+  }
+
+  /**
+  Solve a nonlinear algebraic equation using the safeguarded variant of the algorithm
+
+  The iterations are terminated early if the approximate solution or the function value is not finite, if the first-order derivative is zero, if the absolute value of the function does not decrease in two consecutive iterations (SolveDiverged), or if the update is too small to change the approximate solution (SolveStagnated). Consequently, a failed solve costs a few function evaluations instead of maxit.
+
+  @param[in]    f  function object
+  @param[in]    x0 initial guess
+  @param[inout] ws workspace
+
+  @returns the result
+  */
+  public:
+  SolveResult solveSafeguarded(const Fun &f, const double x0, HiSolveWorkspace &ws) const { return iterateSafeguarded(f, x0, 0.0, 0.0, false, ws); }
+
+  /**
+  Solve a nonlinear algebraic equation with a bracket using the safeguarded variant of the algorithm
+
+  The function must change sign in the bracket [a, b]. In each iteration, the bracket is shrunk using the sign of the function, and the high-order update is only accepted if the new approximate solution is inside the bracket and the width of the bracket has been (at least) halved within the last two iterations. Otherwise, a bisection step is taken. Consequently, the iterations always converge (at least linearly). The function value at a and b is computed using two additional function evaluations.
+
+  @param[in]    f  function object
+  @param[in]    x0 initial guess (the midpoint of the bracket is used if x0 is not inside the bracket)
+  @param[in]    a  one end of the bracket
+  @param[in]    b  the other end of the bracket
+  @param[inout] ws workspace
+
+  @returns the result (the status is SolveNoSignChange if the function does not change sign in the bracket)
+  */
+  public:
+  SolveResult solveSafeguarded(const Fun &f, const double x0, const double a, const double b, HiSolveWorkspace &ws) const { return iterateSafeguarded(f, x0, a, b, true, ws); }
+
+  /**
+  Solve a nonlinear algebraic equation using the safeguarded variant of the algorithm (see solveSafeguarded(const Fun&, const double, HiSolveWorkspace&) const)
+
+  @param[in] f  function object
+  @param[in] x0 initial guess
+
+  @returns the approximate solution
+  */
+  public:
+  double solveSafeguarded(const Fun &f, const double x0) const {
+    HiSolveWorkspace ws(Nmax_);
+    return solveSafeguarded(f, x0, ws).x;
+  }
+
+  /**
+  Solve a nonlinear algebraic equation with a bracket using the safeguarded variant of the algorithm (see solveSafeguarded(const Fun&, const double, const double, const double, HiSolveWorkspace&) const)
+
+  @param[in] f  function object
+  @param[in] x0 initial guess
+  @param[in] a  one end of the bracket
+  @param[in] b  the other end of the bracket
+
+  @returns the approximate solution
+  */
+  public:
+  double solveSafeguarded(const Fun &f, const double x0, const double a, const double b) const {
+    HiSolveWorkspace ws(Nmax_);
+    return solveSafeguarded(f, x0, a, b, ws).x;
+  }
+
+  /**
+  Solve a nonlinear algebraic equation without evaluating any derivatives (derivative-free variant)
+
+  Only the function value is requested from the function object (i.e. eval is always called with N = 0), and the function is evaluated once in each iteration. The derivatives used by the update strategy are estimated by the derivatives of the polynomial which interpolates the function at the last (up to) Nmax+1 approximate solutions, i.e. using Newton divided differences over the iteration history. The second point in the history is the initial guess perturbed by cbrt(machine epsilon)*max(1, |x0|), such that the first iteration is a secant step. For Nmax = 1, the variant is the secant method, and for larger values of Nmax, the order of convergence approaches 2 (but the cost of an iteration is a single function evaluation). The variant of the algorithm (see setUseMaxOrder) is not used.
+
+  The iterations are terminated early if the approximate solution or the function value is not finite, if the estimated first-order derivative is zero, or if the update is too small to change the approximate solution (SolveStagnated). The workspace must hold the iteration history, i.e. it is reserved for derivativeFreeWorkspaceSize() values.
+
+  @param[in]    f  function object
+  @param[in]    x0 initial guess
+  @param[inout] ws workspace
+
+  @returns the result (SolveResult::df only contains the function value)
+  */
+  public:
+  SolveResult solveDerivativeFree(const Fun &f, const double x0, HiSolveWorkspace &ws) const;
+
+  /**
+  Solve a nonlinear algebraic equation without evaluating any derivatives (see solveDerivativeFree(const Fun&, const double, HiSolveWorkspace&) const)
+
   @param[in] f  function object
   @param[in] x0 initial guess
+
+  @returns the approximate solution
+  */
+  public:
+  double solveDerivativeFree(const Fun &f, const double x0) const {
+    HiSolveWorkspace ws;
+    ws.reserveValues(derivativeFreeWorkspaceSize());
+    return solveDerivativeFree(f, x0, ws).x;
+  }
+
+  /**
+  Get the number of values in the workspace of the derivative-free variant, i.e. the estimated function value and derivatives, the iteration history, the divided differences (Nmax+2 values each), and the scratch values of update strategy 4 (2*(Nmax+1) values)
+
+  @returns the number of values (see HiSolveWorkspace::reserveValues)
+  */
+  public:
+  size_t derivativeFreeWorkspaceSize() const { return 6*Nmax_ + 10; }
+
+  /**
+  Solve a batch of n independent nonlinear algebraic equations
+
+  The equations are solved simultaneously in lanes: the function is evaluated for all unconverged lanes at once using Fun::evalBatch, and the update strategy is applied to all lanes using loops over the lanes (which the compiler vectorizes, e.g. using AVX2 or AVX-512 instructions). A per-lane mask keeps track of which lanes have converged, and converged lanes are removed from subsequent function evaluations. Lanes which reach the maximum number of iterations are stopped and flagged as not converged.
+
+  @param[in]  f         function object
+  @param[in]  n         number of equations
+  @param[in]  x0        initial guesses (n values)
+  @param[out] x         approximate solutions (n values)
+  @param[out] Converged whether or not each of the n equations converged (ignored if null)
+
+  @returns the number of equations which converged
+  */
+  public:
+  size_t solveBatch(const Fun &f, const size_t n, const double *x0, double *x, bool *Converged = nullptr) const;
+
+  /**
+  Compute approximate high-order updates for a batch of n lanes using the current update strategy
+
+  This function allows other batched solvers (e.g. CubicEos) to be built on the update strategies.
+
+  @param[in]  N   number of terms to include in the approximation
+  @param[in]  n   number of lanes
+  @param[in]  df  function values and derivatives (up to order N) in SoA layout, i.e. the k'th order derivative of the i'th lane is df[k*n + i]
+  @param[out] dx  the updates (n values)
+  @param[out] aux auxiliary workspace (n values)
   */
   public:
-  double solve(const Fun &f, const double x0);
+  void updateBatch(const size_t N, const size_t n, const double *df, double *dx, double *aux) const { (this->*updateStrategyBatch)(N, n, df, dx, aux); }
 
   /**
   Strategy 1 for computing a approximate high-order update
 
-  @param[in] N number of terms to include in the approximation
+  @param[in] df   function value and derivatives
+  @param[in] N    number of terms to include in the approximation
+  @param[in] work workspace of strategy 4 (not used)
   */
   private:
-  double updateStrategy1(const size_t N) const;
+  double updateStrategy1(const double *df, const size_t N, double *work) const;
 
   /**
   Strategy 2 for computing a approximate high-order update
 
-  @param[in] N number of terms to include in the approximation
+  @param[in] df   function value and derivatives
+  @param[in] N    number of terms to include in the approximation
+  @param[in] work workspace of strategy 4 (not used)
   */
   private:
-  double updateStrategy2(const size_t N) const;
+  double updateStrategy2(const double *df, const size_t N, double *work) const;
 
   /**
   Strategy 3 for computing an approximate high-order update
 
-  @param[in] N number of terms to include in the approximation
+  @param[in] df   function value and derivatives
+  @param[in] N    number of terms to include in the approximation
+  @param[in] work workspace of strategy 4 (not used)
+  */
+  private:
+  double updateStrategy3(const double *df, const size_t N, double *work) const;
+
+  /**
+  Strategy 4 for computing an approximate high-order update (the root of a Pade approximant, see hiSolvePadeUpdate)
+
+  @param[in] df   function value and derivatives
+  @param[in] N    number of terms to include in the approximation
+  @param[in] work workspace (2*(N+1) values, see HiSolveWorkspace::work)
+  */
+  private:
+  double updateStrategy4(const double *df, const size_t N, double *work) const;
+
+  /**
+  Strategy 1 for computing approximate high-order updates for a batch of n lanes
+
+  @param[in]  N   number of terms to include in the approximation
+  @param[in]  n   number of lanes
+  @param[in]  df  function values and derivatives in SoA layout
+  @param[out] dx  the updates (n values)
+  @param[out] aux auxiliary workspace (n values)
+  */
+  private:
+  void updateStrategyBatch1(const size_t N, const size_t n, const double *df, double *dx, double *aux) const;
+
+  /**
+  Strategy 2 for computing approximate high-order updates for a batch of n lanes
+
+  @param[in]  N   number of terms to include in the approximation
+  @param[in]  n   number of lanes
+  @param[in]  df  function values and derivatives in SoA layout
+  @param[out] dx  the updates (n values)
+  @param[out] aux auxiliary workspace (n values)
+  */
+  private:
+  void updateStrategyBatch2(const size_t N, const size_t n, const double *df, double *dx, double *aux) const;
+
+  /**
+  Strategy 3 for computing approximate high-order updates for a batch of n lanes
+
+  @param[in]  N   number of terms to include in the approximation
+  @param[in]  n   number of lanes
+  @param[in]  df  function values and derivatives in SoA layout
+  @param[out] dx  the updates (n values)
+  @param[out] aux auxiliary workspace (n values)
+  */
+  private:
+  void updateStrategyBatch3(const size_t N, const size_t n, const double *df, double *dx, double *aux) const;
+
+  /**
+  Strategy 4 for computing approximate high-order updates for a batch of n lanes
+
+  @param[in]  N   number of terms to include in the approximation
+  @param[in]  n   number of lanes
+  @param[in]  df  function values and derivatives in SoA layout
+  @param[out] dx  the updates (n values)
+  @param[out] aux auxiliary workspace (n values, not used)
+  */
+  private:
+  void updateStrategyBatch4(const size_t N, const size_t n, const double *df, double *dx, double *aux) const;
+
+  /**
+  Internal function iterating using the update strategy chosen at run time (used if Nmax exceeds NmaxSpecialized)
+
+  @param[in] eval   callable evaluating the function and its derivatives
+  @param[in] more   callable evaluating additional derivatives (see hiSolveIterate)
+  @param[in] Staged whether or not to use the staged protocol
+  @param[in] df     the function value and derivatives
+  @param[in] work   workspace of update strategy 4 (see HiSolveWorkspace::work)
+  @param[in] x0     initial guess
+  @param[in] trace  tracing policy (see hiSolveIterate)
+
+  @returns the result (see hiSolveIterate)
+  */
+  private:
+  template<class Eval, class More, class Trace = HiSolveNoTrace>
+  SolveResult iterate(Eval &&eval, More &&more, const bool Staged, const DfSpan &df, double *work, const double x0, Trace &&trace = Trace()) const {
+    const auto upd    = [this, work](const DfSpan &df, const size_t N){ return (this->*updateStrategy)(df.data(), N, work); };
+    const auto terms  = [this](const size_t it){ return N(it); };
+    const auto order  = [this](const size_t N){ return Order(N); };
+    double x = x0;
+    return hiSolveIterate(eval, more, Staged, upd, terms, order, df, x, tol_, maxit_, trace);
+  }
+
+  /**
+  Internal function iterating in a given scalar type using the update strategy chosen at run time (used by solveMixed)
+
+  The function values and derivatives are stored on the stack unless Nmax + 2 exceeds HiSolveWorkspace::InlineSize.
+
+  @param[in]    f    callable which is generic in the scalar type
+  @param[inout] x    initial guess on entry and approximate solution on exit
+  @param[in]    tol  tolerance for terminating the iterations
+  @param[in]    seed the function value and derivatives up to (and including) order Order(N(0)) at the initial guess, which are used instead of the first evaluation (null if they have not been evaluated)
+
+  @returns the result (SolveResult::df is empty)
+  */
+  private:
+  template<class F, class T>
+  SolveResult iterateScalar(F &f, T &x, const double tol, const T *seed = nullptr) const {
+    // Function value and derivatives
+    T inline_[HiSolveWorkspace::InlineSize];
+    std::vector<T> heap;
+    if(Nmax_ + 2 > HiSolveWorkspace::InlineSize){ heap.resize(Nmax_ + 2); }
+    T *df = heap.empty() ? inline_ : heap.data();
+
+    const auto eval   = [&f, &seed](const T x, const size_t N, T *df){
+      if(seed){ std::copy(seed, seed + N+1, df); seed = nullptr; }
+      else    { f(x, N, df); }
+    };
+    const auto more   = [](const T, const size_t, const size_t, T*){};
+    const auto upd    = [this](T *df, const size_t N){ return hiSolveUpdate(UpdateStrategy_, df, N); };
+    const auto terms  = [this](const size_t it){ return N(it); };
+    const auto order  = [this](const size_t N){ return Order(N); };
+    SolveResult result = hiSolveIterate(eval, more, false, upd, terms, order, df, x, tol, maxit_);
+    result.df = DfSpan(nullptr, 0);
+
+    return result;
+  }
+
+  /**
+  Internal function iterating a batch of n lanes in a given scalar type using the update strategy chosen at run time (used by solveBatchMixed)
+
+  The lanes are iterated in blocks like in solveBatch, and the tolerance of each lane is the larger of the tolerance and rel times the absolute value of the function at its initial guess.
+
+  @param[in]    f   callable which is generic in the scalar type (see solveBatchMixed)
+  @param[in]    n   number of lanes
+  @param[inout] x   initial guesses on entry and approximate solutions on exit (n values)
+  @param[in]    rel relative reduction of the residuals after which a lane has converged (zero to use the tolerance)
+  @param[out]   ok  whether or not each lane converged (n values)
+
+  @returns the number of lanes which converged
+  */
+  private:
+  template<class F, class T>
+  size_t iterateBatch(F &f, const size_t n, T *x, const double rel, unsigned char *ok) const {
+    // Number of lanes solved together (as in solveBatch)
+    const size_t BlockSize = 512;
+
+    // Workspace (the highest-order derivative used is Order(Nmax_))
+    std::vector<T>      xa  (BlockSize);                     // Approximations for the active (unconverged) lanes
+    std::vector<T>      dx  (BlockSize);                     // Updates
+    std::vector<T>      aux (BlockSize);                     // Auxiliary workspace for the update strategies
+    std::vector<T>      dfa ((Order(Nmax_) + 1)*BlockSize);  // Function values and derivatives in SoA layout
+    std::vector<double> tola(BlockSize);                     // Tolerances of the active lanes
+    std::vector<size_t> idx (BlockSize);                     // Indices of the active lanes
+    std::vector<unsigned char> mask(BlockSize);              // Per-lane convergence mask
+
+    // Number of converged lanes
+    size_t nConverged = 0;
+
+    for(size_t offset = 0; offset < n; offset += BlockSize){
+      // Number of active lanes in this block
+      size_t na = std::min(BlockSize, n - offset);
+
+      // Copy the initial guesses, evaluate the function and its derivatives, and set the tolerances
+      for(size_t j = 0; j != na; ++j){
+        idx[j] = offset + j;
+        xa [j] = x[offset + j];
+      } // End for j
+      f(xa.data(), na, Order(N(0)), dfa.data());
+      for(size_t j = 0; j != na; ++j){
+        tola[j] = std::max(tol_, rel*std::fabs(static_cast<double>(dfa[j])));
+      } // End for j
+
+      // Iterate until all lanes have converged or the maximum number of iterations is reached
+      size_t it = 0;
+      while(na > 0){
+        // Per-lane convergence mask
+        for(size_t j = 0; j != na; ++j){
+          mask[j] = std::fabs(static_cast<double>(dfa[j])) < tola[j];
+        } // End for j
+
+        // Stop all remaining lanes if the maximum number of iterations has been reached
+        if(it == maxit_){
+          for(size_t j = 0; j != na; ++j){
+            x [idx[j]] = xa[j];
+            ok[idx[j]] = mask[j];
+            nConverged += mask[j];
+          } // End for j
+
+          break;
+        } // End if it == maxit_
+
+        // Increment the iteration counter
+        ++it;
+
+        // Compute updates for all lanes (the updates of converged lanes are discarded)
+        hiSolveUpdateBatch(UpdateStrategy_, N(it), na, dfa.data(), dx.data(), aux.data());
+
+        // Retire converged lanes and update (and compact) the remaining lanes
+        size_t nb = 0;
+        for(size_t j = 0; j != na; ++j){
+          if(mask[j]){
+            x [idx[j]] = xa[j];
+            ok[idx[j]] = 1;
+            ++nConverged;
+          }
+          else{
+            idx [nb] = idx[j];
+            tola[nb] = tola[j];
+            xa  [nb] = xa[j] + dx[j];
+            ++nb;
+          } // End if mask[j]
+        } // End for j
+        na = nb;
+
+        // Evaluate the function and its derivatives for the remaining lanes
+        if(na > 0){
+          f(xa.data(), na, Order(N(it)), dfa.data());
+        } // End if na > 0
+      } // End while na > 0
+    } // End for offset
+
+    return nConverged;
+  }
+
+  /**
+  Internal function iterating using the adaptive-order variant (see setAdaptiveOrder)
+
+  @param[in] eval   callable evaluating the function and its derivatives
+  @param[in] more   callable evaluating additional derivatives (see hiSolveIterate)
+  @param[in] Staged whether or not to use the staged protocol
+  @param[in] df     the function value and derivatives
+  @param[in] work   workspace of update strategy 4 (see HiSolveWorkspace::work)
+  @param[in] x0     initial guess
+  @param[in] trace  tracing policy (see hiSolveIterate)
+
+  @returns the result
+  */
+  private:
+  template<class Eval, class More, class Trace = HiSolveNoTrace>
+  SolveResult iterateAdaptive(Eval &&eval, More &&more, const bool Staged, const DfSpan &df, double *work, const double x0, Trace &&trace = Trace()) const {
+    SolveResult result;
+
+    // Copy the initial guess
+    double x = x0;
+
+    // Evaluate the function (and the derivatives unless the staged protocol is used, nothing is known about the step size yet)
+    size_t it     = 0;
+    size_t Order0 = Order(N(0));
+    size_t Avail  = Staged ? 0 : Order0;
+    trace.beginSolve();
+    trace.beginEval();
+    eval(x, Avail, df);
+    trace.endEval();
+    result.evaluations  = 1;
+    result.order        = Avail;
+
+    // Observed fraction of the nominal order of convergence, and step size and nominal order of the previous iteration
+    double rho   = 1.0;
+    double dx0   = 0.0;
+    double p0    = 0.0;
+
+    // Iterate until termination
+    while(true){
+      // Check for termination
+      if(!std::isfinite(x) || !std::isfinite(df[0])){ result.status = SolveNonFinite;       break; }
+      if(std::fabs(df[0]) < tol_)                   { result.status = SolveConverged;       break; }
+      if(it == maxit_)                              { result.status = SolveMaxIterations;   break; }
+
+      // Evaluate the derivatives needed for the update
+      if(Avail < Order0){
+        trace.beginEval();
+        more(x, Avail, Order0, df);
+        trace.endEval();
+        Avail         = Order0;
+        result.order  = std::max(result.order, Order0);
+      } // End if Avail < Order0
+
+      if(df[1] == 0.0)                              { result.status = SolveZeroDerivative;  break; }
+
+      // Increment the iteration counter
+      ++it;
+
+      // Newton-step size and the step size which corresponds to the tolerance
+      const double dxn  = std::fabs(df[0]/df[1]);
+      const double tolx = tol_/std::fabs(df[1]);
+
+      // Observed order of convergence, i.e. log(dx_k)/log(dx_{k-1}), relative to the nominal order
+      if(p0 > 1.0 && dx0 < 1.0 && dxn < dx0){
+        rho = std::min(std::max((std::log(dxn)/std::log(dx0) - 1.0)/(p0 - 1.0), 0.1), 1.0);
+      } // End if asymptotic
+
+      // Compute update using all of the available derivatives and update approximation of solution
+      const size_t Nit = std::max(std::min(Order0, Nmax_), size_t(1));
+      const double dx  = updateTruncated(df.data(), Nit, tolx, work);
+      trace.iteration(it, x, df[0], dx, Avail, Nit, [&](const size_t N){ return updateTruncated(df.data(), N, tolx, work); });
+      x += dx;
+
+      // Choose the order maximizing the efficiency index in the next iteration (based on the predicted number of correct digits)
+      p0  = nominalOrder(Nit);
+      dx0 = dxn;
+      Order0 = dxn < 1.0 ? chooseOrder(-(1.0 + rho*(p0 - 1.0))*std::log10(dxn), -std::log10(tolx), rho) : Order(N(it));
+
+      // Evaluate the function and its derivatives
+      Avail = Staged ? 0 : Order0;
+      trace.beginEval();
+      eval(x, Avail, df);
+      trace.endEval();
+      ++result.evaluations;
+      result.order = std::max(result.order, Avail);
+    } // End while true
+
+    result.x          = x;
+    result.f          = df[0];
+    result.df         = DfSpan(df.data(), Avail+1, df.stride());
+    result.iterations = it;
+
+    return result;
+  }
+
+  /**
+  Internal function iterating using the safeguarded variant (see solveSafeguarded)
+
+  @param[in]    f         function object
+  @param[in]    x0        initial guess
+  @param[in]    a         one end of the bracket
+  @param[in]    b         the other end of the bracket
+  @param[in]    Bracketed whether or not to use the bracket
+  @param[inout] ws        workspace
+
+  @returns the result
+  */
+  private:
+  SolveResult iterateSafeguarded(const Fun &f, const double x0, double a, double b, const bool Bracketed, HiSolveWorkspace &ws) const;
+
+  /**
+  Internal function returning the cost of evaluating the function value and derivatives up to order N (see setOrderCosts)
+  */
+  private:
+  double orderCost(const size_t N) const;
+
+  /**
+  Internal function returning the nominal order of convergence when N terms are used
+  */
+  private:
+  double nominalOrder(const size_t N) const { return UpdateStrategy_ == 1 ? 2.0 : N+1.0; }
+
+  /**
+  Internal function choosing the number of terms which maximizes the efficiency index
+
+  @param[in] d   the predicted number of correct digits
+  @param[in] dt  the number of correct digits needed for convergence
+  @param[in] rho the observed fraction of the nominal order of convergence
+
+  @returns the number of terms to use
+  */
+  private:
+  size_t chooseOrder(const double d, const double dt, const double rho) const;
+
+  /**
+  Internal function computing an approximate high-order update using the current update strategy, where no more terms are added once the correction is below a tolerance
+
+  @param[in] df    function value and derivatives
+  @param[in] N     highest number of terms to include in the approximation
+  @param[in] tolDx tolerance for the corrections
+  @param[in] work  workspace of update strategy 4 (2*(N+1) values, see HiSolveWorkspace::work)
+
+  @returns the update
   */
   private:
-  double updateStrategy3(const size_t N) const;
+  double updateTruncated(const double *df, const size_t N, const double tolDx, double *work) const;
 
   /**
   Internal function returning the number of terms used in a given iteration
@@ -0,0 +1,124 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_LATENCY_FUN_H
+#define HI_SOLVE_LATENCY_FUN_H
+
+// Standard library headers
+#include <chrono> // For steady_clock
+#include <condition_variable> // For std::condition_variable
+#include <cstddef> // For size_t
+#include <future> // For std::promise and std::future
+#include <map> // For std::multimap
+#include <mutex> // For std::mutex
+#include <thread> // For std::thread
+
+// Asynchronous function base class
+#include <hi-solve-async.h>
+
+/// A stand-in for a high-latency evaluator (e.g. an external simulator) used for testing asynchronous solves
+
+/**
+Each evaluation of the wrapped function completes a fixed latency after it was requested, regardless of how many evaluations are outstanding, i.e. the stand-in behaves like a remote service with unlimited capacity. The requests are kept in a queue ordered by their due times and are completed by a single timer thread, so hundreds of evaluations can be outstanding without hundreds of threads.
+
+@see AsyncFun, HiSolveScheduler
+*/
+
+class LatencyFun : public AsyncFun {
+  // Internal data structure for each outstanding evaluation
+  private:
+  struct Request {
+    double              x;        // Point at which the function is evaluated
+    size_t              N;        // Highest-order derivative to evaluate
+    DfSpan              df;       // Storage for the function value and derivatives
+    std::promise<void>  promise;  // Signals the completion of the evaluation
+  };
+
+  typedef std::chrono::steady_clock Clock;
+
+  // Internal data members
+  private:
+    const Fun                          &f_;           // The wrapped function
+    Clock::duration                     latency_;     // Latency of each evaluation
+    mutable std::mutex                  mutex_;       // Protects the members below
+    mutable std::condition_variable     wake_;        // Signals a new request (or that the timer thread must stop)
+    mutable std::multimap<Clock::time_point, Request> requests_; // Outstanding evaluations ordered by their due times
+    mutable size_t                      evaluations_; // Number of evaluations requested
+    mutable size_t                      peak_;        // Largest number of outstanding evaluations
+    bool                                stop_;        // Whether or not the timer thread must stop
+    std::thread                         timer_;       // Timer thread completing the evaluations
+
+  /**
+  Constructor starting the timer thread
+
+  @param[in] f       the wrapped function (must outlive the stand-in)
+  @param[in] latency latency of each evaluation
+  */
+  public:
+  LatencyFun(const Fun &f, const std::chrono::microseconds latency);
+
+  /**
+  Destructor completing the outstanding evaluations and stopping the timer thread
+  */
+  public:
+  ~LatencyFun();
+
+  // The stand-in owns a thread, so it cannot be copied
+  LatencyFun(const LatencyFun&) = delete;
+  LatencyFun &operator=(const LatencyFun&) = delete;
+
+  /**
+  Request the evaluation of the function value and derivatives (see AsyncFun::evalAsync)
+
+  @param[in]  x  the point at which the function is evaluated
+  @param[in]  N  the highest-order derivative to evaluate
+  @param[out] df storage for the function value and derivatives (must remain valid until the future is ready)
+
+  @returns a future which becomes ready after the latency
+  */
+  public:
+  std::future<void> evalAsync(const double x, const size_t N, DfSpan df) const override;
+
+  /**
+  Get the number of evaluations requested
+
+  @returns the number of evaluations
+  */
+  public:
+  size_t getEvaluations() const;
+
+  /**
+  Get the largest number of evaluations which have been outstanding at the same time
+
+  @returns the largest number of outstanding evaluations
+  */
+  public:
+  size_t getPeakOutstanding() const;
+
+  // Complete the evaluations when they are due (run by the timer thread)
+  private:
+  void run();
+};
+
+#endif
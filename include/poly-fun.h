@@ -0,0 +1,258 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_POLY_FUN_H
+#define HI_SOLVE_POLY_FUN_H
+
+// Standard library headers
+#include <vector> // For std::vector
+#include <cstddef> // For size_t
+#include <algorithm> // For min
+
+// Abstract function base class
+#include <fun.h>
+
+/// A polynomial function object which evaluates all derivatives in a single sweep
+
+/**
+This class represents the polynomial
+
+  p(x) = a[0] + a[1]*x + ... + a[m]*x^m
+
+of degree m. The function value and all derivatives up to order N are computed simultaneously using repeated synthetic division (the extended Horner scheme), which requires O(m*N) operations. The scheme produces the normalized Taylor coefficients, p^(k)(x)/k!, which are converted to derivatives using a precomputed table of factorials.
+
+@see Fun
+*/
+
+class PolyFun : public Fun {
+  // Internal data members
+  private:
+    std::vector<double> a_;   // Coefficients in ascending order (contiguous)
+    std::vector<double> fac_; // Factorials, fac_[k] = k!, k = 0, 1, ..., m
+
+  /**
+  Constructor
+
+  @param[in] a the coefficients in ascending order, i.e. a[i] is the coefficient of x^i (must not be empty)
+  */
+  public:
+  PolyFun(const std::vector<double> &a);
+
+  /**
+  Get the degree of the polynomial
+
+  @returns the degree of the polynomial
+  */
+  public:
+  size_t getDegree() const { return a_.size() - 1; }
+
+  /**
+  Get the coefficients of the polynomial
+
+  @returns the coefficients in ascending order
+  */
+  public:
+  const std::vector<double> &getCoefficients() const { return a_; }
+
+  /**
+  Get the table of factorials
+
+  @returns the factorials k!, k = 0, 1, ..., m
+  */
+  public:
+  const std::vector<double> &getFactorials() const { return fac_; }
+
+  /**
+  Evaluate the normalized Taylor coefficients, p^(k)(x)/k!, k = 0, 1, ..., N
+
+  @param[in]  x the scalar value to evaluate the polynomial at
+  @param[in]  N the highest order to be evaluated
+  @param[out] t the normalized Taylor coefficients (must hold at least N+1 values)
+  */
+  public:
+  void evalTaylor(const double x, const size_t N, double *t) const;
+
+  /**
+  Evaluate the polynomial and up to (and including) its N'th order derivative in a given scalar type
+
+  The arithmetic is carried out in the scalar type (e.g. float, double, or DoubleDouble), while the coefficients are stored as doubles. This makes PolyFun usable with HiSolve::solveMixed, e.g. through the lambda [&p](auto x, size_t N, auto *df){ p.evalGeneric(x, N, df); }.
+
+  @param[in]  x   the scalar value to evaluate the polynomial at
+  @param[in]  N   the highest-order derivative to be evaluated
+  @param[out] df  the values of the polynomial and its derivatives (must hold at least N+1 values)
+  */
+  public:
+  template<class T>
+  void evalGeneric(const T x, const size_t N, T *df) const {
+    // Normalized Taylor coefficients
+    syntheticDivision(x, N, df);
+
+    // Convert to derivatives
+    for(size_t k = 2; k <= std::min(N, getDegree()); ++k){
+      df[k] *= T(fac_[k]);
+    } // End for k
+  }
+
+  /**
+  Evaluate the polynomial and up to (and including) its N'th order derivative
+
+  @param[in]  x   the scalar value to evaluate the polynomial at
+  @param[in]  N   the highest-order derivative to be evaluated
+  @param[out] df  the values of the polynomial and its derivatives
+  */
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override;
+
+  /**
+  Evaluate the derivatives of order N0+1, ..., N (staged evaluation, see Fun::evalMore)
+
+  Each derivative is evaluated using Horner's scheme for the coefficients of the derivative (whose factors are updated in each step), i.e. in O(m) operations, such that evaluating the function value first (in O(m) operations) and the derivatives afterwards costs about the same as the extended Horner scheme.
+
+  @param[in]    x   the scalar value to evaluate the polynomial at
+  @param[in]    N0  the highest-order derivative which has already been evaluated
+  @param[in]    N   the highest-order derivative to be evaluated
+  @param[inout] df  the values of the polynomial and its derivatives
+  */
+  public:
+  void evalMore(const double x, const size_t N0, const size_t N, DfSpan df) const override;
+
+  /**
+  Get whether or not HiSolve should use the staged protocol
+
+  @returns true
+  */
+  public:
+  bool hasStagedEval() const override { return true; }
+
+  /**
+  Evaluate the polynomial and up to (and including) its N'th order derivative for a batch of n scalar values
+
+  The synthetic division is carried out for all n values simultaneously in SIMD lanes.
+
+  @param[in]  x     the n scalar values to evaluate the polynomial at
+  @param[in]  n     the number of scalar values
+  @param[in]  N     the highest-order derivative to be evaluated
+  @param[out] dfSoA the values of the polynomial and its derivatives in SoA layout (see Fun::evalBatch)
+  */
+  public:
+  void evalBatch(const double *x, const size_t n, const size_t N, double *dfSoA) const override;
+
+  /**
+  Evaluate the polynomial and up to (and including) its N'th order derivative for a batch of n scalar values in a given scalar type
+
+  The arithmetic is carried out in the scalar type (e.g. float or double), while the coefficients are stored as doubles. In float, twice as many values are processed per SIMD instruction as in double. This makes PolyFun usable with HiSolve::solveBatchMixed, e.g. through the lambda [&p](const auto *x, size_t n, size_t N, auto *df){ p.evalBatchGeneric(x, n, N, df); }.
+
+  @param[in]  x     the n scalar values to evaluate the polynomial at
+  @param[in]  n     the number of scalar values
+  @param[in]  N     the highest-order derivative to be evaluated
+  @param[out] dfSoA the values of the polynomial and its derivatives in SoA layout (see Fun::evalBatch)
+  */
+  public:
+  template<class T>
+  void evalBatchGeneric(const T *x, const size_t n, const size_t N, T *dfSoA) const {
+    // Degree and highest nonzero order
+    const size_t m  = getDegree();
+    const size_t Nm = std::min(N, m);
+
+    // Initialize with the leading coefficient
+    const T am = T(a_[m]);
+    for(size_t j = 0; j != n; ++j){
+      dfSoA[j] = am;
+    } // End for j
+    for(size_t j = n; j != (N+1)*n; ++j){
+      dfSoA[j] = T(0.0);
+    } // End for j
+
+    // Repeated synthetic division
+    for(size_t i = m; i-- != 0;){
+      for(size_t k = std::min(Nm, m-i); k != 0; --k){
+        T       *tk   = dfSoA + k*n;
+        const T *tkm1 = dfSoA + (k-1)*n;
+        for(size_t j = 0; j != n; ++j){
+          tk[j] = tk[j]*x[j] + tkm1[j];
+        } // End for j
+      } // End for k
+
+      const T ai = T(a_[i]);
+      for(size_t j = 0; j != n; ++j){
+        dfSoA[j] = dfSoA[j]*x[j] + ai;
+      } // End for j
+    } // End for i
+
+    // Convert to derivatives
+    for(size_t k = 2; k <= Nm; ++k){
+      T      *tk  = dfSoA + k*n;
+      const T fac = T(fac_[k]);
+      for(size_t j = 0; j != n; ++j){
+        tk[j] *= fac;
+      } // End for j
+    } // End for k
+  }
+
+  /**
+  Evaluate n different polynomials of the same degree and up to (and including) their N'th order derivatives
+
+  The i'th coefficient of the j'th polynomial is a[i*n + j] (i.e. the coefficients are stored in SoA layout), and the j'th polynomial is evaluated at x[j]. The synthetic division is carried out for all n polynomials simultaneously in SIMD lanes.
+
+  @param[in]  m     the degree of the polynomials
+  @param[in]  n     the number of polynomials
+  @param[in]  a     the coefficients in SoA layout ((m+1)*n values)
+  @param[in]  x     the n scalar values to evaluate the polynomials at
+  @param[in]  N     the highest-order derivative to be evaluated
+  @param[out] dfSoA the values of the polynomials and their derivatives in SoA layout (see Fun::evalBatch)
+  */
+  public:
+  static void evalMany(const size_t m, const size_t n, const double *a, const double *x, const size_t N, double *dfSoA);
+
+  /**
+  Internal function carrying out repeated synthetic division, i.e. computing the normalized Taylor coefficients
+
+  @param[in]  x the scalar value to evaluate the polynomial at (of the scalar type used in the arithmetic)
+  @param[in]  N the highest order to be evaluated
+  @param[out] t the normalized Taylor coefficients (a pointer or a DfSpan)
+  */
+  private:
+  template<class X, class T>
+  void syntheticDivision(const X x, const size_t N, const T &t) const {
+    // Degree and highest nonzero order
+    const size_t m  = getDegree();
+    const size_t Nm = std::min(N, m);
+
+    // Initialize with the leading coefficient
+    t[0] = X(a_[m]);
+    for(size_t k = 1; k != N+1; ++k){
+      t[k] = X(0.0);
+    } // End for k
+
+    // Repeated synthetic division (only the orders which can be nonzero after m-i divisions are updated)
+    for(size_t i = m; i-- != 0;){
+      for(size_t k = std::min(Nm, m-i); k != 0; --k){
+        t[k] = t[k]*x + t[k-1];
+      } // End for k
+      t[0] = t[0]*x + X(a_[i]);
+    } // End for i
+  }
+};
+
+#endif
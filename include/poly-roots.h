@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_POLY_ROOTS_H
+#define HI_SOLVE_POLY_ROOTS_H
+
+// Standard library headers
+#include <complex> // For std::complex
+#include <cstddef> // For size_t
+#include <vector> // For std::vector
+
+// Solver used for polishing the real roots
+#include <hi-solve.h>
+
+// Polynomial function object
+#include <poly-fun.h>
+
+/// A real root of a polynomial and its multiplicity
+
+struct PolyRoot {
+  double  x;            ///< The root
+  size_t  multiplicity; ///< The multiplicity of the root
+};
+
+/// A solver computing all roots of a polynomial simultaneously
+
+/**
+All m roots of a polynomial of degree m are computed simultaneously using the Aberth-Ehrlich iteration, i.e. the Newton correction of each approximate root is modified by the repulsion from all other approximate roots. Approximate roots are frozen once they have converged (i.e. once the function value cannot be decreased further in double precision), but they still repel the remaining approximate roots, i.e. the converged roots are implicitly deflated and are not found again. Each iteration costs O(m^2) operations, i.e. the cost scales with the degree rather than with a number of initial guesses. Roots at zero are deflated explicitly before the iterations.
+
+For each approximate root, the radius of an inclusion disc (which contains a root) is computed from the function value (accounting for rounding errors) and the distances to the other approximate roots. Approximate roots whose inclusion discs overlap (or which are closer than the cluster tolerance) are merged into one root whose multiplicity is the size of the cluster and whose value is the centroid of the cluster (for a multiple root, the centroid is much more accurate than the individual approximate roots). Real roots are then polished using the high-order updates of HiSolve: a root with multiplicity k is a simple root of the (k-1)'th order derivative of the polynomial, which is solved using the centroid as the initial guess.
+
+@see PolyFun, HiSolve
+*/
+
+class PolyRoots {
+  // Internal data members
+  private:
+    HiSolve solver_;      // Solver used for polishing the real roots
+    size_t  maxit_;       // Maximum number of Aberth-Ehrlich iterations
+    double  ClusterTol_;  // Relative distance below which approximate roots are always merged
+
+  /**
+  Constructor
+
+  @param[in] solver     solver used for polishing the real roots
+  @param[in] maxit      maximum number of Aberth-Ehrlich iterations
+  @param[in] ClusterTol relative distance below which approximate roots are always merged into a multiple root (even if their inclusion discs do not overlap)
+  */
+  public:
+  PolyRoots(const HiSolve &solver, const size_t maxit = 100, const double ClusterTol = 1.0e-12) : solver_(solver), maxit_(maxit), ClusterTol_(ClusterTol) {}
+
+  /**
+  Compute all (complex) roots of a polynomial using the Aberth-Ehrlich iteration (without merging or polishing)
+
+  @param[in] p the polynomial (leading zero coefficients are ignored)
+
+  @returns the roots (as many as the degree of the polynomial, counting multiplicity)
+  */
+  public:
+  std::vector<std::complex<double>> roots(const PolyFun &p) const;
+
+  /**
+  Compute the distinct real roots of a polynomial in an interval
+
+  @param[in] p the polynomial
+  @param[in] a the left end of the interval
+  @param[in] b the right end of the interval
+
+  @returns the distinct real roots in [a, b] and their multiplicities (in ascending order)
+  */
+  public:
+  std::vector<PolyRoot> realRoots(const PolyFun &p, const double a, const double b) const;
+};
+
+#endif
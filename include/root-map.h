@@ -0,0 +1,121 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_ROOT_MAP_H
+#define HI_SOLVE_ROOT_MAP_H
+
+// Standard library headers
+#include <cstddef> // For size_t
+#include <string> // For std::string
+
+// Solver, parametrized functions, and tabulated piecewise polynomials
+#include <hi-solve.h>
+#include <hi-solve-continuation.h>
+#include <table-fun.h>
+
+/// A precomputed approximant of the root map x*(p) of a parametrized equation f(x; p) = 0
+
+/**
+The builder samples the root map on [pmin, pmax] by tracking the root with HiSolveContinuation, and computes the tangents dx/dp = -(df/dp)/(df/dx) of the root given by the implicit function theorem. On each segment between two samples, the approximant is the cubic Hermite interpolant of the roots and tangents at the ends (i.e. the approximant and its first derivative are continuous). The error of each segment is estimated at its midpoint (where the error of cubic Hermite interpolation is largest) by solving for the root there, and segments are bisected until the estimated error is below the requested accuracy.
+
+The approximant is stored as a TableFun file with a nonuniform grid (see TableFun for the binary format), i.e. it is compact, memory-mapped when loaded, and each query costs a binary search over the breakpoints and the evaluation of a cubic polynomial. Outside of [pmin, pmax], the first and the last segment are extrapolated. If more accuracy is needed, polish performs a single high-order step of HiSolve using the original function.
+
+@see HiSolveContinuation, TableFun
+*/
+
+class RootMap {
+  // Internal data members
+  private:
+    TableFun table_; // The approximant (x*(p) as a function of p)
+
+  /**
+  Constructor loading an approximant (throws if the file is not a valid table)
+
+  @param[in] path the name of the file
+  */
+  public:
+  RootMap(const std::string &path) : table_(path) {}
+
+  /**
+  Get the approximant as a function of the parameter (e.g. for evaluating the derivative of the root with respect to p)
+
+  @returns the tabulated piecewise polynomial
+  */
+  public:
+  const TableFun &getTable() const { return table_; }
+
+  /**
+  Get the number of segments
+
+  @returns the number of segments
+  */
+  public:
+  size_t getSegments() const { return table_.getSegments(); }
+
+  /**
+  Approximate the root
+
+  @param[in] p the parameter
+
+  @returns the approximate root x*(p)
+  */
+  public:
+  double operator()(const double p) const {
+    double df[1];
+    table_.eval(p, 0, DfSpan(df, 1));
+    return df[0];
+  }
+
+  /**
+  Approximate the root and improve it by a single high-order step using the original function
+
+  @param[in] f        the family of functions
+  @param[in] p        the parameter
+  @param[in] N        the number of terms in the update, i.e. the highest-order derivative evaluated (the order of convergence of the step is N+1)
+  @param[in] Strategy the update strategy (1, 2, 3, or 4, see HiSolve)
+
+  @returns the improved root
+  */
+  public:
+  double polish(const ParamFun &f, const double p, const size_t N = 2, const size_t Strategy = 3) const;
+
+  /**
+  Build an approximant of the root map and write it to a file
+
+  @param[in] path        the name of the file
+  @param[in] f           the family of functions
+  @param[in] solver      the solver used for sampling the root map
+  @param[in] x0          initial guess of the root at pmin
+  @param[in] pmin        the smallest parameter value
+  @param[in] pmax        the largest parameter value (must be larger than pmin)
+  @param[in] tol         the requested (absolute) accuracy of the approximant (must be positive)
+  @param[in] MaxSegments the largest number of segments (the builder throws if the accuracy cannot be reached)
+
+  @returns the number of segments
+  */
+  public:
+  static size_t build(const std::string &path, const ParamFun &f, const HiSolve &solver, const double x0, const double pmin, const double pmax, const double tol, const size_t MaxSegments = 1000000);
+};
+
+#endif
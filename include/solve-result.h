@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_SOLVE_RESULT_H
+#define HI_SOLVE_SOLVE_RESULT_H
+
+// Standard library headers
+#include <cstddef> // For size_t
+
+// Abstract function base class (and DfSpan)
+#include <fun.h>
+
+/// Reasons for terminating the iterations
+
+enum SolveStatus {
+  SolveConverged,       ///< The absolute value of the function is below the tolerance
+  SolveMaxIterations,   ///< The maximum number of iterations has been reached
+  SolveNonFinite,       ///< The approximate solution or the function value is not finite (inf or NaN)
+  SolveZeroDerivative,  ///< The first-order derivative is zero, so the update cannot be computed
+  SolveDiverged,        ///< The absolute value of the function did not decrease in two consecutive iterations (only detected by HiSolve::solveSafeguarded)
+  SolveStagnated,       ///< The approximate solution (or the bracket) cannot be improved in double precision (only detected by HiSolve::solveSafeguarded and HiSolve::solveDerivativeFree)
+  SolveNoSignChange     ///< The function has the same sign at both ends of the bracket (only detected by HiSolve::solveSafeguarded)
+};
+
+/// The result of solving a nonlinear algebraic equation
+
+/**
+Apart from the approximate solution, the result contains the function value and derivatives which were evaluated at the approximate solution in the last iteration, such that it is not necessary to evaluate the function again in order to check the result.
+
+@see HiSolve
+*/
+
+struct SolveResult {
+  double      x           = 0.0;              ///< The approximate solution
+  double      xLow        = 0.0;              ///< The trailing part of the approximate solution, i.e. x + xLow, if it was polished in double-double precision (see HiSolve::solveMixed), and zero otherwise
+  double      f           = 0.0;              ///< The function value at the approximate solution (the residual)
+  DfSpan      df          = DfSpan(nullptr, 0); ///< The function value and derivatives at the approximate solution (a view of the workspace which is valid until the workspace is used again)
+  size_t      iterations  = 0;                ///< The number of iterations
+  size_t      evaluations = 0;                ///< The number of function evaluations
+  size_t      order       = 0;                ///< The highest order of derivatives requested from the function
+  SolveStatus status      = SolveMaxIterations; ///< The reason for terminating the iterations
+
+  /**
+  Get whether or not the iterations converged
+
+  @returns true if the iterations converged
+  */
+  bool converged() const { return status == SolveConverged; }
+};
+
+#endif
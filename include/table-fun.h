@@ -0,0 +1,189 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_TABLE_FUN_H
+#define HI_SOLVE_TABLE_FUN_H
+
+// Standard library headers
+#include <cstddef> // For size_t
+#include <cstdint> // For uint64_t
+#include <string> // For std::string
+#include <vector> // For std::vector
+
+// Abstract function base class
+#include <fun.h>
+
+/// A function object representing a tabulated piecewise polynomial which is memory-mapped from a binary file
+
+/**
+The function is a piecewise polynomial of degree m on n segments [x_i, x_{i+1}), i = 0, 1, ..., n-1. On the i'th segment, it is represented by its normalized Taylor coefficients at the left breakpoint, i.e.
+
+  f(x) = c[i][0] + c[i][1]*t + ... + c[i][m]*t^m,   t = x - x_i,
+
+such that the function value and all derivatives are exact derivatives of the piecewise polynomial (derivatives of order higher than m are zero). Outside of [x_0, x_n], the first and the last segment are extrapolated.
+
+The table is memory-mapped (read-only) from a file, i.e. the coefficients are never copied, and only the pages containing the segments which are actually evaluated are read from the disk. For uniform grids (x_i = x0 + i*h), the segment is located in O(1) operations. For nonuniform grids, it is located using binary search over the breakpoints.
+
+The binary format consists of native-endian 64-bit words (all offsets are multiples of 8 bytes):
+
+  offset  0: the magic number "HSTABLE1" (8 characters)
+  offset  8: m, the degree of the polynomials (uint64)
+  offset 16: n, the number of segments (uint64, at least 1)
+  offset 24: the kind of grid, 0 for uniform and 1 for nonuniform (uint64)
+  offset 32: x0, the first breakpoint (double)
+  offset 40: h, the distance between breakpoints for uniform grids and 0 otherwise (double)
+  offset 48: for nonuniform grids only, the n+1 breakpoints x_0 < x_1 < ... < x_n (double)
+  followed by the n*(m+1) coefficients c[i][k], stored at index i*(m+1) + k (double)
+
+Tables can be written using the static member functions write (for precomputed coefficients) and writeInterpolant (for gridded data).
+
+@see Fun
+*/
+
+class TableFun : public Fun {
+  // Internal data members
+  private:
+    void          *map_;    // The memory-mapped file
+    size_t        bytes_;   // Size of the memory-mapped file
+    size_t        m_;       // Degree of the polynomials
+    size_t        n_;       // Number of segments
+    double        x0_;      // First breakpoint
+    double        h_;       // Distance between breakpoints (uniform grids)
+    double        rh_;      // Reciprocal distance between breakpoints (uniform grids)
+    const double  *x_;      // Breakpoints (nonuniform grids, null for uniform grids)
+    const double  *c_;      // Coefficients
+    std::vector<double> fac_; // Factorials, fac_[k] = k!, k = 0, 1, ..., m
+
+  /**
+  Constructor memory-mapping a table (throws if the file cannot be mapped or is not a valid table)
+
+  @param[in] path the name of the file
+  */
+  public:
+  TableFun(const std::string &path);
+
+  /**
+  Destructor unmapping the table
+  */
+  public:
+  ~TableFun();
+
+  // The mapping is owned by the object, so it cannot be copied
+  public:
+  TableFun(const TableFun&) = delete;
+  TableFun &operator=(const TableFun&) = delete;
+
+  /**
+  Get the degree of the polynomials
+
+  @returns the degree
+  */
+  public:
+  size_t getDegree() const { return m_; }
+
+  /**
+  Get the number of segments
+
+  @returns the number of segments
+  */
+  public:
+  size_t getSegments() const { return n_; }
+
+  /**
+  Get whether or not the grid is uniform
+
+  @returns true if the breakpoints are equidistant
+  */
+  public:
+  bool isUniform() const { return x_ == nullptr; }
+
+  /**
+  Get the index of the segment containing a scalar value
+
+  @param[in] x the scalar value
+
+  @returns the index of the segment (the first or the last segment outside of the table)
+  */
+  public:
+  size_t segment(const double x) const;
+
+  /**
+  Get the left breakpoint of a segment
+
+  @param[in] i the index of the segment (or n for the last breakpoint)
+
+  @returns the breakpoint
+  */
+  public:
+  double breakpoint(const size_t i) const { return x_ ? x_[i] : x0_ + i*h_; }
+
+  /**
+  Evaluate the piecewise polynomial and up to (and including) its N'th order derivative
+
+  @param[in]  x   the scalar value to evaluate the function at
+  @param[in]  N   the highest-order derivative to be evaluated
+  @param[out] df  the values of the function and its derivatives
+  */
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override;
+
+  /**
+  Write a table with precomputed coefficients on a uniform grid
+
+  @param[in] path the name of the file
+  @param[in] m    the degree of the polynomials
+  @param[in] x0   the first breakpoint
+  @param[in] h    the distance between breakpoints (must be positive)
+  @param[in] c    the normalized Taylor coefficients at the left breakpoints, c[i*(m+1) + k] (the number of segments is c.size()/(m+1))
+  */
+  public:
+  static void write(const std::string &path, const size_t m, const double x0, const double h, const std::vector<double> &c);
+
+  /**
+  Write a table with precomputed coefficients on a nonuniform grid
+
+  @param[in] path the name of the file
+  @param[in] m    the degree of the polynomials
+  @param[in] x    the n+1 breakpoints (must be increasing)
+  @param[in] c    the normalized Taylor coefficients at the left breakpoints, c[i*(m+1) + k] (n*(m+1) values)
+  */
+  public:
+  static void write(const std::string &path, const size_t m, const std::vector<double> &x, const std::vector<double> &c);
+
+  /**
+  Write a table interpolating gridded data on a uniform grid
+
+  On each segment, the polynomial of degree m interpolates the data at the m+1 grid points closest to the segment (which include both ends of the segment), i.e. the piecewise polynomial is continuous, and it is exact for polynomials of degree up to m. The pieces are local Lagrange interpolants rather than a spline, i.e. the derivatives are not continuous at the breakpoints (they jump by O(h^(m+1-k)) for the k'th derivative). Tables with smoother pieces (e.g. splines or Chebyshev pieces) can be written using write.
+
+  @param[in] path the name of the file
+  @param[in] m    the degree of the polynomials (at least 1 and at most the number of segments)
+  @param[in] x0   the first grid point
+  @param[in] h    the distance between grid points (must be positive)
+  @param[in] y    the data at the grid points x0 + j*h (at least two values)
+  */
+  public:
+  static void writeInterpolant(const std::string &path, const size_t m, const double x0, const double h, const std::vector<double> &y);
+};
+
+#endif
@@ -0,0 +1,407 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef HI_SOLVE_TAYLOR_H
+#define HI_SOLVE_TAYLOR_H
+
+// Standard library headers
+#include <cmath> // For exp, log, sin, cos, pow, and sqrt
+#include <cstddef> // For size_t
+#include <utility> // For std::index_sequence
+
+// Abstract function base class
+#include <fun.h>
+
+/// A truncated Taylor series, i.e. a number type for computing high-order derivatives automatically
+
+/**
+An object of this class represents the Taylor coefficients, c[k] = f^(k)(x)/k!, k = 0, 1, ..., N, of a function f expanded around a point x. The arithmetic operators and the elementary functions (exp, log, sin, cos, pow, and sqrt) propagate all coefficients at once using the standard recurrences for Taylor coefficients (i.e. with O(N^2) operations), such that evaluating a function written in terms of them yields all derivatives up to order N in a single pass.
+
+@tparam T the scalar type of the coefficients
+@tparam N the highest order of the truncated Taylor series
+
+@see TaylorFun
+*/
+
+template<class T, size_t N>
+class Taylor {
+  // Internal data members
+  private:
+    T c_[N+1]; // Taylor coefficients
+
+  /**
+  Constructor initializing the Taylor series to zero
+  */
+  public:
+  Taylor() : c_() {}
+
+  /**
+  Constructor initializing the Taylor series to a constant
+
+  @param[in] a the constant
+  */
+  public:
+  Taylor(const T &a) : c_() { c_[0] = a; }
+
+  /**
+  Create the Taylor series of the independent variable expanded around x, i.e. x + epsilon
+
+  @param[in] x the point to expand around
+
+  @returns the Taylor series of the independent variable
+  */
+  public:
+  static Taylor variable(const T &x){
+    Taylor t(x);
+    if(N > 0){ t.c_[1] = T(1); }
+    return t;
+  }
+
+  /**
+  Get the k'th Taylor coefficient
+
+  @param[in] k the order of the coefficient
+
+  @returns a reference to the k'th Taylor coefficient
+  */
+  public:
+  T &operator[](const size_t k){ return c_[k]; }
+
+  /**
+  Get the k'th Taylor coefficient
+
+  @param[in] k the order of the coefficient
+
+  @returns the k'th Taylor coefficient
+  */
+  public:
+  const T &operator[](const size_t k) const { return c_[k]; }
+
+  /**
+  Get the function value
+
+  @returns the function value (i.e. the 0'th Taylor coefficient)
+  */
+  public:
+  const T &value() const { return c_[0]; }
+
+  /**
+  Get the k'th order derivative
+
+  @param[in] k the order of the derivative
+
+  @returns the k'th order derivative (i.e. k! times the k'th Taylor coefficient)
+  */
+  public:
+  T derivative(const size_t k) const {
+    T d = c_[k];
+    for(size_t l = 2; l <= k; ++l){ d *= T(l); }
+    return d;
+  }
+
+  // Compound assignment operators
+  public:
+  Taylor &operator+=(const Taylor &b){ for(size_t k = 0; k != N+1; ++k){ c_[k] += b.c_[k]; } return *this; }
+  Taylor &operator-=(const Taylor &b){ for(size_t k = 0; k != N+1; ++k){ c_[k] -= b.c_[k]; } return *this; }
+  Taylor &operator+=(const T &b){ c_[0] += b; return *this; }
+  Taylor &operator-=(const T &b){ c_[0] -= b; return *this; }
+  Taylor &operator*=(const T &b){ for(size_t k = 0; k != N+1; ++k){ c_[k] *= b; } return *this; }
+  Taylor &operator/=(const T &b){ for(size_t k = 0; k != N+1; ++k){ c_[k] /= b; } return *this; }
+  Taylor &operator*=(const Taylor &b){ return *this = *this*b; }
+  Taylor &operator/=(const Taylor &b){ return *this = *this/b; }
+
+  // Unary operators
+  public:
+  friend Taylor operator+(const Taylor &a){ return a; }
+  friend Taylor operator-(const Taylor &a){ Taylor h; for(size_t k = 0; k != N+1; ++k){ h.c_[k] = -a.c_[k]; } return h; }
+
+  // Addition and subtraction
+  public:
+  friend Taylor operator+(Taylor a, const Taylor &b){ return a += b; }
+  friend Taylor operator-(Taylor a, const Taylor &b){ return a -= b; }
+  friend Taylor operator+(Taylor a, const T &b){ return a += b; }
+  friend Taylor operator-(Taylor a, const T &b){ return a -= b; }
+  friend Taylor operator+(const T &a, Taylor b){ return b += a; }
+  friend Taylor operator-(const T &a, const Taylor &b){ Taylor h = -b; return h += a; }
+
+  // Multiplication: h[k] = sum_{j=0}^{k} a[j]*b[k-j]
+  public:
+  friend Taylor operator*(const Taylor &a, const Taylor &b){
+    Taylor h;
+    for(size_t k = 0; k != N+1; ++k){
+      for(size_t j = 0; j != k+1; ++j){
+        h.c_[k] += a.c_[j]*b.c_[k-j];
+      } // End for j
+    } // End for k
+    return h;
+  }
+  friend Taylor operator*(Taylor a, const T &b){ return a *= b; }
+  friend Taylor operator*(const T &a, Taylor b){ return b *= a; }
+
+  // Division: h[k] = (a[k] - sum_{j=0}^{k-1} h[j]*b[k-j])/b[0]
+  public:
+  friend Taylor operator/(const Taylor &a, const Taylor &b){
+    Taylor h;
+    for(size_t k = 0; k != N+1; ++k){
+      T s = a.c_[k];
+      for(size_t j = 0; j != k; ++j){
+        s -= h.c_[j]*b.c_[k-j];
+      } // End for j
+      h.c_[k] = s/b.c_[0];
+    } // End for k
+    return h;
+  }
+  friend Taylor operator/(Taylor a, const T &b){ return a /= b; }
+  friend Taylor operator/(const T &a, const Taylor &b){ return Taylor(a)/b; }
+
+  // Comparisons (of the function values)
+  public:
+  friend bool operator< (const Taylor &a, const Taylor &b){ return a.c_[0] <  b.c_[0]; }
+  friend bool operator> (const Taylor &a, const Taylor &b){ return a.c_[0] >  b.c_[0]; }
+  friend bool operator<=(const Taylor &a, const Taylor &b){ return a.c_[0] <= b.c_[0]; }
+  friend bool operator>=(const Taylor &a, const Taylor &b){ return a.c_[0] >= b.c_[0]; }
+};
+
+/**
+Exponential of a Taylor series, h = exp(a), using h[k] = 1/k sum_{j=1}^{k} j*a[j]*h[k-j]
+*/
+template<class T, size_t N>
+Taylor<T, N> exp(const Taylor<T, N> &a){
+  using std::exp;
+  Taylor<T, N> h;
+  h[0] = exp(a[0]);
+  for(size_t k = 1; k != N+1; ++k){
+    T s = T(0);
+    for(size_t j = 1; j != k+1; ++j){
+      s += T(j)*a[j]*h[k-j];
+    } // End for j
+    h[k] = s/T(k);
+  } // End for k
+  return h;
+}
+
+/**
+Natural logarithm of a Taylor series, h = log(a), using h[k] = (a[k] - 1/k sum_{j=1}^{k-1} j*h[j]*a[k-j])/a[0]
+*/
+template<class T, size_t N>
+Taylor<T, N> log(const Taylor<T, N> &a){
+  using std::log;
+  Taylor<T, N> h;
+  h[0] = log(a[0]);
+  for(size_t k = 1; k != N+1; ++k){
+    T s = T(0);
+    for(size_t j = 1; j != k; ++j){
+      s += T(j)*h[j]*a[k-j];
+    } // End for j
+    h[k] = (a[k] - s/T(k))/a[0];
+  } // End for k
+  return h;
+}
+
+/**
+Simultaneous sine and cosine of a Taylor series, s = sin(a) and c = cos(a), using s[k] = 1/k sum_{j=1}^{k} j*a[j]*c[k-j] and c[k] = -1/k sum_{j=1}^{k} j*a[j]*s[k-j]
+
+The two recurrences are coupled, so computing both at once is as cheap as computing either of them.
+*/
+template<class T, size_t N>
+void sincos(const Taylor<T, N> &a, Taylor<T, N> &s, Taylor<T, N> &c){
+  using std::sin;
+  using std::cos;
+  s[0] = sin(a[0]);
+  c[0] = cos(a[0]);
+  for(size_t k = 1; k != N+1; ++k){
+    T ss = T(0);
+    T cs = T(0);
+    for(size_t j = 1; j != k+1; ++j){
+      const T ja = T(j)*a[j];
+      ss += ja*c[k-j];
+      cs += ja*s[k-j];
+    } // End for j
+    s[k] =  ss/T(k);
+    c[k] = -cs/T(k);
+  } // End for k
+}
+
+/**
+Sine of a Taylor series (see sincos)
+*/
+template<class T, size_t N>
+Taylor<T, N> sin(const Taylor<T, N> &a){
+  Taylor<T, N> s, c;
+  sincos(a, s, c);
+  return s;
+}
+
+/**
+Cosine of a Taylor series (see sincos)
+*/
+template<class T, size_t N>
+Taylor<T, N> cos(const Taylor<T, N> &a){
+  Taylor<T, N> s, c;
+  sincos(a, s, c);
+  return c;
+}
+
+/**
+Power of a Taylor series with a constant exponent, h = a^r, using h[k] = 1/(k*a[0]) sum_{j=1}^{k} (r*j - k + j)*a[j]*h[k-j]
+*/
+template<class T, size_t N>
+Taylor<T, N> pow(const Taylor<T, N> &a, const T &r){
+  using std::pow;
+  Taylor<T, N> h;
+  h[0] = pow(a[0], r);
+  for(size_t k = 1; k != N+1; ++k){
+    T s = T(0);
+    for(size_t j = 1; j != k+1; ++j){
+      s += (r*T(j) - T(k) + T(j))*a[j]*h[k-j];
+    } // End for j
+    h[k] = s/(T(k)*a[0]);
+  } // End for k
+  return h;
+}
+
+/**
+Power of a Taylor series with an integer exponent (computed by repeated squaring, so a[0] may be zero or negative)
+*/
+template<class T, size_t N>
+Taylor<T, N> pow(Taylor<T, N> a, int n){
+  if(n < 0){ return T(1)/pow(a, -n); }
+  Taylor<T, N> h(T(1));
+  while(n > 0){
+    if(n%2 == 1){ h *= a; }
+    n /= 2;
+    if(n > 0){ a *= a; }
+  } // End while n > 0
+  return h;
+}
+
+/**
+Power of a Taylor series with a Taylor series as exponent, h = a^b = exp(b*log(a))
+*/
+template<class T, size_t N>
+Taylor<T, N> pow(const Taylor<T, N> &a, const Taylor<T, N> &b){
+  return exp(b*log(a));
+}
+
+/**
+Square root of a Taylor series, h = sqrt(a), using h[k] = (a[k] - sum_{j=1}^{k-1} h[j]*h[k-j])/(2*h[0])
+*/
+template<class T, size_t N>
+Taylor<T, N> sqrt(const Taylor<T, N> &a){
+  using std::sqrt;
+  Taylor<T, N> h;
+  h[0] = sqrt(a[0]);
+  for(size_t k = 1; k != N+1; ++k){
+    T s = a[k];
+    for(size_t j = 1; j != k; ++j){
+      s -= h[j]*h[k-j];
+    } // End for j
+    h[k] = s/(T(2)*h[0]);
+  } // End for k
+  return h;
+}
+
+/// A function object which computes its derivatives automatically using truncated Taylor series
+
+/**
+The function is represented by a generic callable (e.g. a generic lambda, [](const auto &x){ return x*sin(x) - 1.0; }) which is evaluated once at x + epsilon using the Taylor number type. All derivatives up to the requested order are obtained from that single evaluation. The callable is instantiated for each order 0, 1, ..., Nmax, such that the cost of an evaluation only depends on the order requested by HiSolve.
+
+@tparam Nmax the highest order of derivatives which can be requested (the variable-order variant of HiSolve requests up to order HiSolve::getNmax() + 1)
+@tparam F    the type of the generic callable
+
+@see Taylor
+*/
+
+template<size_t Nmax, class F>
+class TaylorFun : public Fun {
+  // Internal data members
+  private:
+    F f_; // Generic callable
+
+  /**
+  Constructor
+
+  @param[in] f the generic callable
+  */
+  public:
+  TaylorFun(const F &f) : f_(f) {}
+
+  /**
+  Evaluate the function and up to (and including) its N'th order derivative
+
+  @param[in]  x   the scalar value to evaluate the function at
+  @param[in]  N   the highest-order derivative to be evaluated (at most Nmax)
+  @param[out] df  the values of the function and its derivatives
+  */
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    if(N > Nmax){
+      throw "The requested order of derivatives exceeds the highest order supported by the TaylorFun.";
+    } // End if N > Nmax
+
+    table(std::make_index_sequence<Nmax+1>())[N](f_, x, df);
+  }
+
+  /**
+  Internal function evaluating the callable using Taylor series truncated at order K
+  */
+  private:
+  template<size_t K>
+  static void evalOrder(const F &f, const double x, DfSpan df){
+    const Taylor<double, K> y = f(Taylor<double, K>::variable(x));
+
+    // Convert the Taylor coefficients to derivatives
+    double fac = 1.0;
+    for(size_t k = 0; k != K+1; ++k){
+      if(k > 1){ fac *= k; }
+      df[k] = fac*y[k];
+    } // End for k
+  }
+
+  /**
+  Internal function returning the table of evaluation functions for the orders 0, 1, ..., Nmax
+  */
+  private:
+  template<size_t... K>
+  static void (* const *table(std::index_sequence<K...>))(const F&, const double, DfSpan) {
+    static void (* const t[])(const F&, const double, DfSpan) = { &evalOrder<K>... };
+    return t;
+  }
+};
+
+/**
+Create a TaylorFun from a generic callable
+
+@tparam Nmax the highest order of derivatives which can be requested
+
+@param[in] f the generic callable
+
+@returns the function object
+*/
+template<size_t Nmax, class F>
+TaylorFun<Nmax, F> makeTaylorFun(const F &f){
+  return TaylorFun<Nmax, F>(f);
+}
+
+#endif
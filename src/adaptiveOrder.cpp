@@ -0,0 +1,86 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard library headers
+#include <chrono> // For steady_clock
+
+// Class header
+#include <hi-solve.h>
+
+double HiSolve::orderCost(const size_t N) const {
+  // Default cost model: each derivative costs the same as the function value
+  if(OrderCosts_.empty()){ return N+1.0; }
+
+  // User-specified or measured cost
+  const size_t n = OrderCosts_.size();
+  if(N < n){ return OrderCosts_[N]; }
+
+  // Extrapolate linearly beyond the highest order in the cost model
+  const double last = OrderCosts_[n-1];
+  return n > 1 ? last + (N - (n-1))*(last - OrderCosts_[n-2]) : last*(N+1);
+}
+
+size_t HiSolve::chooseOrder(const double d, const double dt, const double rho) const {
+  // The number of terms with the largest efficiency index (ties are resolved in favour of the cheapest)
+  size_t Nbest   = 1;
+  double EffBest = -1.0;
+  for(size_t N = 1; N <= std::max(Nmax_, size_t(1)); ++N){
+    // Digits gained (no more than needed for convergence) per unit cost
+    const double p   = 1.0 + rho*(nominalOrder(N) - 1.0);
+    const double Eff = std::max(std::min(p*d, dt) - d, 0.0)/orderCost(N);
+
+    if(Eff > EffBest){
+      Nbest   = N;
+      EffBest = Eff;
+    } // End if Eff > EffBest
+  } // End for N
+
+  return Nbest;
+}
+
+double HiSolve::updateTruncated(const double *df, const size_t N, const double tolDx, double *work) const {
+  // Root of the Pade approximant (which adds terms until the correction is below the tolerance)
+  if(UpdateStrategy_ == 4){ return hiSolvePadeUpdate(df, N, work, tolDx); }
+
+  // Shared kernel of strategies 1, 2, and 3
+  return hiSolveTaylorUpdate(UpdateStrategy_, df, N, tolDx);
+}
+
+std::vector<double> HiSolve::measureOrderCosts(const Fun &f, const double x, const size_t Nmax, const size_t repetitions){
+  std::vector<double> costs(Nmax+1);
+  std::vector<double> df(Nmax+2);
+
+  for(size_t N = 0; N != Nmax+1; ++N){
+    // Time the evaluation of the function value and derivatives up to order N
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t rep = 0; rep != repetitions; ++rep){ f.eval(x, N, df); }
+    const auto stop = std::chrono::steady_clock::now();
+    costs[N] = std::chrono::duration<double>(stop - start).count()/repetitions;
+
+    // The cost must be positive and must not decrease with the order (e.g. due to timer noise)
+    costs[N] = std::max(costs[N], N > 0 ? costs[N-1] : 1.0e-12);
+  } // End for N
+
+  return costs;
+}
@@ -0,0 +1,183 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <batch-driver.h>
+
+// Standard library headers
+#include <algorithm> // For max and min
+#include <chrono> // For std::chrono::steady_clock
+
+// The size of a chunk is the number of remaining problems in the range divided by this number
+static const size_t ChunkDivisor = 8;
+
+BatchDriver::BatchDriver(const HiSolve &solver, const size_t nthreads, const size_t MinChunk) :
+  solver_(solver), MinChunk_(std::max(MinChunk, (size_t) 1)), generation_(0), active_(0), stop_(false), task_(nullptr) {
+  // Number of threads
+  const size_t nt = nthreads > 0 ? nthreads : std::max(std::thread::hardware_concurrency(), 1u);
+
+  // Create the workers before starting any threads
+  for(size_t i = 0; i != nt; ++i){
+    workers_.emplace_back(new Worker(solver.getNmax()));
+  } // End for i
+
+  for(size_t i = 0; i != nt; ++i){
+    threads_.emplace_back(&BatchDriver::work, this, i);
+  } // End for i
+}
+
+BatchDriver::~BatchDriver(){
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+
+  for(std::thread &t : threads_){
+    t.join();
+  } // End for t
+}
+
+std::vector<BatchDriverStats> BatchDriver::getStats() const {
+  std::vector<BatchDriverStats> stats;
+  for(const std::unique_ptr<Worker> &w : workers_){
+    stats.push_back(w->stats);
+  } // End for w
+  return stats;
+}
+
+void BatchDriver::run(const size_t n, const Task &task){
+  const size_t nt = workers_.size();
+
+  // Split the problems into one contiguous range per thread
+  for(size_t i = 0; i != nt; ++i){
+    Worker &w = *workers_[i];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    w.begin = n*i/nt;
+    w.end   = n*(i+1)/nt;
+    w.stats = BatchDriverStats();
+  } // End for i
+
+  // Start the threads and wait for them to finish
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_   = &task;
+  active_ = nt;
+  error_  = nullptr;
+  ++generation_;
+  start_.notify_all();
+  done_.wait(lock, [this]{ return active_ == 0; });
+  task_ = nullptr;
+
+  // Rethrow the first exception thrown by a task
+  if(error_){
+    std::rethrow_exception(error_);
+  } // End if error_
+}
+
+void BatchDriver::solve(const Fun &f, const size_t n, const double *x0, double *x){
+  run(n, [this, &f, x0, x](const size_t begin, const size_t end, HiSolveWorkspace &ws){
+    for(size_t i = begin; i != end; ++i){
+      x[i] = solver_.solve(f, x0[i], ws).x;
+    } // End for i
+  });
+}
+
+void BatchDriver::work(const size_t id){
+  Worker &w = *workers_[id];
+  size_t generation = 0;
+
+  while(true){
+    // Wait for a new batch (or for the driver to stop)
+    const Task *task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [this, generation]{ return stop_ || generation_ != generation; });
+      if(stop_){ return; }
+      generation = generation_;
+      task       = task_;
+    }
+
+    // Process chunks until there are no more problems
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    size_t begin, end;
+    while(next(id, begin, end)){
+      try{
+        (*task)(begin, end, w.workspace);
+      } catch(...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(!error_){ error_ = std::current_exception(); }
+      }
+
+      w.stats.problems += end - begin;
+      ++w.stats.chunks;
+    } // End while next chunk
+    w.stats.busyTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // Signal that this thread has finished
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(--active_ == 0){ done_.notify_one(); }
+    }
+  } // End while true
+}
+
+bool BatchDriver::next(const size_t id, size_t &begin, size_t &end){
+  const size_t nt = workers_.size();
+  Worker &w = *workers_[id];
+
+  for(size_t v = 0; v != nt; ++v){
+    // Steal the back half of the remaining range of another thread (if the own range is empty)
+    if(v > 0){
+      Worker &victim = *workers_[(id + v)%nt];
+      size_t sbegin, send;
+      {
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(victim.begin == victim.end){ continue; }
+
+        const size_t remaining = victim.end - victim.begin;
+        sbegin = remaining <= MinChunk_ ? victim.begin : victim.end - remaining/2;
+        send   = victim.end;
+        victim.end = sbegin;
+      }
+
+      std::lock_guard<std::mutex> lock(w.mutex);
+      w.begin = sbegin;
+      w.end   = send;
+      ++w.stats.steals;
+    } // End if v > 0
+
+    // Take a chunk from the front of the own range
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if(w.begin != w.end){
+      const size_t remaining = w.end - w.begin;
+      const size_t chunk     = std::min(remaining, std::max(MinChunk_, remaining/ChunkDivisor));
+      begin    = w.begin;
+      end      = w.begin + chunk;
+      w.begin += chunk;
+      return true;
+    } // End if w.begin != w.end
+  } // End for v
+
+  return false;
+}
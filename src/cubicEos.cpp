@@ -0,0 +1,198 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <cubic-eos.h>
+
+// Standard library headers
+#include <vector> // For std::vector
+#include <cmath> // For fabs, sqrt, and copysign
+#include <algorithm> // For min and max
+
+// Number of cubics solved together (chosen such that the workspace fits in the cache)
+static const size_t BlockSize = 512;
+
+void CubicEos::pengRobinson(const size_t n, const double *A, const double *B, double *c2, double *c1, double *c0){
+  for(size_t j = 0; j != n; ++j){
+    c2[j] = B[j] - 1.0;
+    c1[j] = A[j] - (3.0*B[j] + 2.0)*B[j];
+    c0[j] = ((B[j] + 1.0)*B[j] - A[j])*B[j];
+  } // End for j
+}
+
+void CubicEos::soaveRedlichKwong(const size_t n, const double *A, const double *B, double *c2, double *c1, double *c0){
+  for(size_t j = 0; j != n; ++j){
+    c2[j] = -1.0;
+    c1[j] = A[j] - (B[j] + 1.0)*B[j];
+    c0[j] = -A[j]*B[j];
+  } // End for j
+}
+
+// Compute an initial guess from which the iterations converge monotonically to the largest real root of Z^3 + c2*Z^2 + c1*Z + c0
+static double coldStart(const double c2, const double c1, const double c0){
+  // Bound on the magnitude of the roots
+  const double U = 1.0 + std::max(fabs(c2), std::max(fabs(c1), fabs(c0)));
+
+  // The cubic and its derivative at Z = 1 (a good initial guess for vapor-like roots)
+  const double p1  = ((1.0 + c2) + c1) + c0;
+  const double dp1 = (3.0 + 2.0*c2) + c1;
+
+  // Location of the local minimum (if the cubic is not monotone) or of the inflection point
+  const double d    = c2*c2 - 3.0*c1;
+  const double zmin = d > 0.0 ? (sqrt(d) - c2)/3.0 : -c2/3.0;
+  const double pmin = ((zmin + c2)*zmin + c1)*zmin + c0;
+
+  // If the cubic is positive at its local minimum (or inflection point), the only real root is to the left of it, where the cubic is concave and increasing
+  if(pmin > 0.0){ return -U; }
+
+  // Otherwise, start to the right of the largest root where the cubic is convex and increasing
+  return 1.0 > zmin && dp1 > 0.0 && p1 > 0.0 ? 1.0 : U;
+}
+
+void CubicEos::iterate(const size_t n, const double *c2, const double *c1, const double *c0, double *Z, unsigned char *ok, double *df, double *dx, double *aux) const {
+  // Algorithmic parameters
+  const size_t Nmax  = solver_.getNmax();
+  const double tol   = solver_.getTol();
+  const size_t maxit = solver_.getMaxIt();
+
+  // Derivatives of order 3 (constant) and higher (vanishing)
+  for(size_t k = 3; k <= Nmax; ++k){
+    for(size_t j = 0; j != n; ++j){
+      df[k*n + j] = k == 3 ? 6.0 : 0.0;
+    } // End for j
+  } // End for k
+
+  for(size_t it = 0; ; ++it){
+    // Evaluate the cubics and their derivatives in all lanes
+    for(size_t j = 0; j != n; ++j){
+      const double z = Z[j];
+      df[j]   = ((z + c2[j])*z + c1[j])*z + c0[j];
+      df[n+j] = (3.0*z + 2.0*c2[j])*z + c1[j];
+    } // End for j
+    if(Nmax > 1){
+      for(size_t j = 0; j != n; ++j){
+        df[2*n + j] = 6.0*Z[j] + 2.0*c2[j];
+      } // End for j
+    } // End if Nmax > 1
+
+    // Per-lane convergence mask
+    size_t nConverged = 0;
+    for(size_t j = 0; j != n; ++j){
+      ok[j] = fabs(df[j]) < tol;
+      nConverged += ok[j];
+    } // End for j
+
+    // Stop if all lanes have converged or the maximum number of iterations has been reached
+    if(nConverged == n || it == maxit){ break; }
+
+    // Compute the updates for all lanes and update the unconverged lanes
+    solver_.updateBatch(Nmax, n, df, dx, aux);
+    for(size_t j = 0; j != n; ++j){
+      Z[j] += ok[j] ? 0.0 : dx[j];
+    } // End for j
+  } // End for it
+}
+
+size_t CubicEos::solve(const size_t n, const double *c2, const double *c1, const double *c0, double *Zl, double *Zv, unsigned char *branch, const bool WarmStart) const {
+  // Workspace
+  std::vector<double> df  ((solver_.getNmax() + 1)*BlockSize); // Function values and derivatives in SoA layout
+  std::vector<double> dx  (BlockSize);                          // Updates
+  std::vector<double> aux (BlockSize);                          // Auxiliary workspace for the update strategies
+  std::vector<double> Zr  (BlockSize);                          // The root computed from the initial guess
+  std::vector<double> disc(BlockSize);                          // Discriminants of the deflated quadratics
+  std::vector<unsigned char> okr(BlockSize), okl(BlockSize), okv(BlockSize); // Per-lane convergence masks
+
+  // Number of successfully solved cubics
+  size_t nSolved = 0;
+
+  for(size_t offset = 0; offset < n; offset += BlockSize){
+    // Number of lanes in this block and coefficients of this block
+    const size_t nb = std::min(BlockSize, n - offset);
+    const double *b2 = c2 + offset;
+    const double *b1 = c1 + offset;
+    const double *b0 = c0 + offset;
+
+    // Initial guesses
+    for(size_t j = 0; j != nb; ++j){
+      Zr[j] = WarmStart ? Zv[offset + j] : coldStart(b2[j], b1[j], b0[j]);
+    } // End for j
+
+    // Compute one root of each cubic
+    iterate(nb, b2, b1, b0, Zr.data(), okr.data(), df.data(), dx.data(), aux.data());
+
+    // Restart the lanes in which the warm start failed (e.g. because the iterations are trapped close to a local minimum)
+    if(WarmStart && std::count(okr.begin(), okr.begin() + nb, 0) > 0){
+      for(size_t j = 0; j != nb; ++j){
+        Zr[j] = okr[j] ? Zr[j] : coldStart(b2[j], b1[j], b0[j]);
+      } // End for j
+      iterate(nb, b2, b1, b0, Zr.data(), okr.data(), df.data(), dx.data(), aux.data());
+    } // End if the warm start failed
+
+    // Deflate to a quadratic, Z^2 + q1*Z + q0, and estimate the smallest and largest roots
+    double *zl = Zl + offset;
+    double *zv = Zv + offset;
+    for(size_t j = 0; j != nb; ++j){
+      const double r  = Zr[j];
+      const double q1 = b2[j] + r;
+      const double q0 = b1[j] + r*q1;
+      disc[j] = q1*q1 - 4.0*q0;
+
+      if(disc[j] < 0.0){
+        // A single real root
+        zl[j] = r;
+        zv[j] = r;
+      }
+      else{
+        // Three real roots (the roots of the quadratic are computed in a numerically stable way)
+        const double s  = -0.5*(q1 + copysign(sqrt(disc[j]), q1));
+        const double r1 = s;
+        const double r2 = s != 0.0 ? q0/s : 0.0;
+        zl[j] = std::min(r, std::min(r1, r2));
+        zv[j] = std::max(r, std::max(r1, r2));
+      } // End if disc[j] < 0.0
+    } // End for j
+
+    // Polish the smallest and largest roots (lanes which already hold a root converge immediately)
+    iterate(nb, b2, b1, b0, zl, okl.data(), df.data(), dx.data(), aux.data());
+    iterate(nb, b2, b1, b0, zv, okv.data(), df.data(), dx.data(), aux.data());
+
+    // Determine the root branches
+    for(size_t j = 0; j != nb; ++j){
+      unsigned char b = CubicEosFailed;
+      if(okr[j] && okl[j] && okv[j]){
+        if(disc[j] < 0.0){
+          b = zv[j] < -b2[j]/3.0 ? CubicEosLiquid : CubicEosVapor;
+        }
+        else{
+          b = CubicEosTwoPhase;
+        } // End if disc[j] < 0.0
+        ++nSolved;
+      } // End if converged
+
+      if(branch){ branch[offset + j] = b; }
+    } // End for j
+  } // End for offset
+
+  return nSolved;
+}
@@ -0,0 +1,99 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <latency-fun.h>
+
+// Standard library headers
+#include <exception> // For std::current_exception
+#include <utility> // For std::move
+
+LatencyFun::LatencyFun(const Fun &f, const std::chrono::microseconds latency) :
+  f_(f), latency_(latency), evaluations_(0), peak_(0), stop_(false) {
+  timer_ = std::thread(&LatencyFun::run, this);
+}
+
+LatencyFun::~LatencyFun(){
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  timer_.join();
+}
+
+std::future<void> LatencyFun::evalAsync(const double x, const size_t N, DfSpan df) const {
+  Request request = {x, N, df, std::promise<void>()};
+  std::future<void> future = request.promise.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.emplace(Clock::now() + latency_, std::move(request));
+    ++evaluations_;
+    if(requests_.size() > peak_){ peak_ = requests_.size(); }
+  }
+  wake_.notify_one();
+
+  return future;
+}
+
+size_t LatencyFun::getEvaluations() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return evaluations_;
+}
+
+size_t LatencyFun::getPeakOutstanding() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peak_;
+}
+
+void LatencyFun::run(){
+  std::unique_lock<std::mutex> lock(mutex_);
+  while(true){
+    // Wait for a request to become due (outstanding requests are completed before stopping)
+    if(requests_.empty()){
+      if(stop_){ break; }
+      wake_.wait(lock);
+      continue;
+    } // End if requests_ is empty
+    const auto first = requests_.begin();
+    if(!stop_ && Clock::now() < first->first){
+      wake_.wait_until(lock, first->first);
+      continue;
+    } // End if the first request is not due
+
+    // Complete the evaluation without holding the lock
+    Request request = std::move(first->second);
+    requests_.erase(first);
+    lock.unlock();
+    try{
+      f_.eval(request.x, request.N, request.df);
+      request.promise.set_value();
+    }
+    catch(...){
+      request.promise.set_exception(std::current_exception());
+    } // End try
+    lock.lock();
+  } // End while true
+}
@@ -0,0 +1,124 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <poly-fun.h>
+
+// Standard library headers
+#include <algorithm> // For min
+
+PolyFun::PolyFun(const std::vector<double> &a) : a_(a), fac_(a.size()) {
+  if(a_.empty()){
+    throw "A polynomial must have at least one coefficient.";
+  } // End if a_ is empty
+
+  // Table of factorials
+  fac_[0] = 1.0;
+  for(size_t k = 1; k != fac_.size(); ++k){
+    fac_[k] = k*fac_[k-1];
+  } // End for k
+}
+
+void PolyFun::evalTaylor(const double x, const size_t N, double *t) const {
+  syntheticDivision(x, N, t);
+}
+
+void PolyFun::eval(const double x, const size_t N, DfSpan df) const {
+  // Normalized Taylor coefficients
+  syntheticDivision(x, N, df);
+
+  // Convert to derivatives
+  for(size_t k = 2; k <= std::min(N, getDegree()); ++k){
+    df[k] *= fac_[k];
+  } // End for k
+}
+
+void PolyFun::evalMore(const double x, const size_t N0, const size_t N, DfSpan df) const {
+  const size_t m = getDegree();
+
+  for(size_t k = N0+1; k <= N; ++k){
+    // Derivatives of order higher than the degree are zero
+    if(k > m){
+      df[k] = 0.0;
+      continue;
+    } // End if k > m
+
+    // Falling factorial m*(m-1)*...*(m-k+1) (formed directly because m! overflows for m > 170)
+    double ff = 1.0;
+    for(size_t j = m-k+1; j <= m; ++j){
+      ff *= j;
+    } // End for j
+
+    // Horner's scheme for the coefficients of the k'th order derivative, a[i]*i*(i-1)*...*(i-k+1), where the falling factorial is updated in each step
+    double d = a_[m]*ff;
+    for(size_t i = m; i-- != k;){
+      ff = ff*(i+1-k)/(i+1);
+      d  = d*x + a_[i]*ff;
+    } // End for i
+    df[k] = d;
+  } // End for k
+}
+
+void PolyFun::evalBatch(const double *x, const size_t n, const size_t N, double *dfSoA) const {
+  evalBatchGeneric(x, n, N, dfSoA);
+}
+
+void PolyFun::evalMany(const size_t m, const size_t n, const double *a, const double *x, const size_t N, double *dfSoA){
+  // Highest nonzero order
+  const size_t Nm = std::min(N, m);
+
+  // Initialize with the leading coefficients
+  for(size_t j = 0; j != n; ++j){
+    dfSoA[j] = a[m*n + j];
+  } // End for j
+  for(size_t j = n; j != (N+1)*n; ++j){
+    dfSoA[j] = 0.0;
+  } // End for j
+
+  // Repeated synthetic division
+  for(size_t i = m; i-- != 0;){
+    for(size_t k = std::min(Nm, m-i); k != 0; --k){
+      double       *tk   = dfSoA + k*n;
+      const double *tkm1 = dfSoA + (k-1)*n;
+      for(size_t j = 0; j != n; ++j){
+        tk[j] = tk[j]*x[j] + tkm1[j];
+      } // End for j
+    } // End for k
+
+    const double *ai = a + i*n;
+    for(size_t j = 0; j != n; ++j){
+      dfSoA[j] = dfSoA[j]*x[j] + ai[j];
+    } // End for j
+  } // End for i
+
+  // Convert to derivatives
+  double fac = 1.0;
+  for(size_t k = 2; k <= Nm; ++k){
+    fac *= k;
+    double *tk = dfSoA + k*n;
+    for(size_t j = 0; j != n; ++j){
+      tk[j] *= fac;
+    } // End for j
+  } // End for k
+}
@@ -0,0 +1,226 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <poly-roots.h>
+
+// Standard library headers
+#include <algorithm> // For sort, swap, and max
+#include <cfloat> // For DBL_EPSILON
+#include <cmath> // For pow, fabs, and atan
+
+std::vector<std::complex<double>> PolyRoots::roots(const PolyFun &p) const {
+  typedef std::complex<double> Complex;
+  const std::vector<double> &a = p.getCoefficients();
+
+  // Degree (ignoring leading zero coefficients) and number of roots at zero
+  size_t m = a.size() - 1;
+  while(m > 0 && a[m] == 0.0){ --m; }
+  size_t m0 = 0;
+  while(m0 < m && a[m0] == 0.0){ ++m0; }
+
+  // Deflate the roots at zero
+  std::vector<Complex> z(m0, 0.0);
+  const size_t n = m - m0;
+  if(n == 0){ return z; }
+  const double *c = a.data() + m0;
+
+  // Initial guesses on a circle around the centroid of the roots (with a radius given by the geometric mean of their distances to the centroid)
+  const double Pi     = 4.0*std::atan(1.0);
+  const double center = -c[n-1]/(n*c[n]);
+  double pc = c[n];
+  for(size_t i = n; i-- != 0;){ pc = pc*center + c[i]; }
+  const double R = std::max(std::pow(std::fabs(pc/c[n]), 1.0/n), DBL_EPSILON*(1.0 + std::fabs(center)));
+
+  std::vector<Complex> zn(n);
+  for(size_t k = 0; k != n; ++k){
+    zn[k] = center + std::polar(R, 2.0*Pi*k/n + 0.5*Pi/n);
+  } // End for k
+
+  // Aberth-Ehrlich iterations (the approximate roots are updated one at a time using the latest values of the others)
+  std::vector<unsigned char> done(n, 0);
+  for(size_t it = 0; it != maxit_; ++it){
+    bool AllDone = true;
+    for(size_t i = 0; i != n; ++i){
+      if(done[i]){ continue; }
+
+      // Function value, derivative, and bound on the rounding errors in the function value (Horner's scheme)
+      const Complex zi = zn[i];
+      const double  ri = std::abs(zi);
+      Complex pz  = c[n];
+      Complex dpz = 0.0;
+      double  e   = std::fabs(c[n]);
+      for(size_t j = n; j-- != 0;){
+        dpz = dpz*zi + pz;
+        pz  = pz*zi + c[j];
+        e   = e*ri + std::fabs(c[j]);
+      } // End for j
+
+      // The function value cannot be decreased further in double precision
+      if(std::abs(pz) <= 4.0*DBL_EPSILON*e){
+        done[i] = 1;
+        continue;
+      } // End if converged
+      AllDone = false;
+
+      // Move away from a stationary point
+      if(dpz == 0.0){
+        zn[i] += R*DBL_EPSILON*(1.0 + ri);
+        continue;
+      } // End if dpz == 0
+
+      // Newton correction modified by the repulsion from the other approximate roots
+      const Complex w = pz/dpz;
+      Complex s = 0.0;
+      for(size_t j = 0; j != n; ++j){
+        if(j != i){ s += 1.0/(zi - zn[j]); }
+      } // End for j
+      const Complex delta = w/(1.0 - w*s);
+      zn[i] = zi - delta;
+
+      // The correction is below the resolution of the approximate root
+      if(std::abs(delta) <= DBL_EPSILON*std::abs(zn[i])){ done[i] = 1; }
+    } // End for i
+
+    if(AllDone){ break; }
+  } // End for it
+
+  z.insert(z.end(), zn.begin(), zn.end());
+  return z;
+}
+
+// Radii of inclusion discs of the roots, i.e. each disc centered at an approximate root contains a root (the radius accounts for rounding errors in the function value)
+static std::vector<double> inclusionRadii(const std::vector<double> &a, const std::vector<std::complex<double>> &z){
+  // Degree (ignoring leading zero coefficients)
+  size_t m = a.size() - 1;
+  while(m > 0 && a[m] == 0.0){ --m; }
+
+  std::vector<double> radii(z.size(), 0.0);
+  for(size_t i = 0; i != z.size(); ++i){
+    // Function value and bound on the rounding errors (Horner's scheme)
+    const double ri = std::abs(z[i]);
+    std::complex<double> pz = a[m];
+    double e = std::fabs(a[m]);
+    for(size_t j = m; j-- != 0;){
+      pz = pz*z[i] + a[j];
+      e  = e*ri + std::fabs(a[j]);
+    } // End for j
+    const double num = std::max(std::abs(pz), 4.0*DBL_EPSILON*e);
+    if(num == 0.0){ continue; }
+
+    // Product of the distances to the other approximate roots
+    double prod = std::fabs(a[m]);
+    for(size_t j = 0; j != z.size(); ++j){
+      if(j != i){ prod *= std::abs(z[i] - z[j]); }
+    } // End for j
+
+    radii[i] = z.size()*num/prod;
+  } // End for i
+
+  return radii;
+}
+
+std::vector<PolyRoot> PolyRoots::realRoots(const PolyFun &p, double a, double b) const {
+  if(a > b){ std::swap(a, b); }
+
+  // All approximate roots
+  const std::vector<std::complex<double>> z = roots(p);
+  const size_t m = z.size();
+
+  // Merge approximate roots whose inclusion discs overlap or which are closer than the cluster tolerance (transitively)
+  const std::vector<double> radii = inclusionRadii(p.getCoefficients(), z);
+  std::vector<size_t> cluster(m, m);
+  size_t nc = 0;
+  for(size_t i = 0; i != m; ++i){
+    if(cluster[i] != m){ continue; }
+
+    cluster[i] = nc;
+    std::vector<size_t> queue(1, i);
+    while(!queue.empty()){
+      const size_t j = queue.back();
+      queue.pop_back();
+      for(size_t l = 0; l != m; ++l){
+        if(cluster[l] == m && std::abs(z[l] - z[j]) <= radii[l] + radii[j] + ClusterTol_*std::max(1.0, std::abs(z[j]))){
+          cluster[l] = nc;
+          queue.push_back(l);
+        } // End if close
+      } // End for l
+    } // End while queue is not empty
+    ++nc;
+  } // End for i
+
+  const std::vector<double> &c   = p.getCoefficients();
+  std::vector<PolyRoot> result;
+  HiSolveWorkspace ws(solver_.getNmax());
+  for(size_t k = 0; k != nc; ++k){
+    // Centroid and radius of the cluster, and multiplicity
+    std::complex<double> centroid = 0.0;
+    size_t mult = 0;
+    for(size_t i = 0; i != m; ++i){
+      if(cluster[i] == k){
+        centroid += z[i];
+        ++mult;
+      } // End if cluster[i] == k
+    } // End for i
+    centroid /= double(mult);
+
+    double radius = 0.0;
+    for(size_t i = 0; i != m; ++i){
+      if(cluster[i] == k){ radius = std::max(radius, std::abs(z[i] - centroid) + radii[i]); }
+    } // End for i
+    radius += ClusterTol_*std::max(1.0, std::abs(centroid));
+
+    // Only real roots are of interest
+    if(std::fabs(centroid.imag()) > radius){ continue; }
+    double x = centroid.real();
+
+    // Polish the root, i.e. solve for the simple root of the (mult-1)'th order derivative
+    const size_t d = mult - 1;
+    if(d == 0){
+      const SolveResult r = solver_.solve(p, x, ws);
+      if(r.converged() && std::fabs(r.x - x) <= radius){ x = r.x; }
+    }
+    else if(d < c.size() - 1){
+      // Coefficients of the d'th order derivative, c[i+d]*(i+1)*(i+2)*...*(i+d) (the ratio of factorials overflows for degrees above 170)
+      std::vector<double> cd(c.size() - d);
+      for(size_t i = 0; i != cd.size(); ++i){
+        double ff = 1.0;
+        for(size_t j = i+1; j <= i+d; ++j){
+          ff *= j;
+        } // End for j
+        cd[i] = c[i+d]*ff;
+      } // End for i
+
+      const SolveResult r = solver_.solve(PolyFun(cd), x, ws);
+      if(r.converged() && std::fabs(r.x - x) <= radius){ x = r.x; }
+    } // End if d
+
+    if(x >= a && x <= b){ result.push_back({x, mult}); }
+  } // End for k
+
+  // Sort the roots in ascending order
+  std::sort(result.begin(), result.end(), [](const PolyRoot &r1, const PolyRoot &r2){ return r1.x < r2.x; });
+
+  return result;
+}
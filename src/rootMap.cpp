@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <root-map.h>
+
+// Standard library headers
+#include <cmath> // For fabs and isfinite
+#include <vector> // For std::vector
+
+// A sample of the root map, i.e. the parameter, the root, and the tangent
+struct RootSample {
+  double p;
+  double x;
+  double t;
+};
+
+// Tangent of the root map given by the implicit function theorem
+static double tangent(const ParamFun &f, const double x, const double p){
+  double df[2];
+  f.eval(x, p, 1, DfSpan(df, 2));
+  return -f.evalParam(x, p)/df[1];
+}
+
+// Append the samples in (a, b] needed for approximating the root map on [a, b] to the requested accuracy
+static void refine(const ParamFun &f, const HiSolve &solver, HiSolveWorkspace &ws, const RootSample &a, const RootSample &b, const double tol, const size_t MaxSegments, size_t &segments, std::vector<RootSample> &samples){
+  // Hermite interpolant and root at the midpoint
+  const double d   = b.p - a.p;
+  const double pm  = a.p + 0.5*d;
+  const double xh  = 0.5*(a.x + b.x) + 0.125*d*(a.t - b.t);
+  const SolveResult r = solver.solve(FixedParamFun(f, pm), xh, ws);
+  if(!r.converged()){
+    throw "The root map could not be sampled.";
+  } // End if the root was not found
+
+  // Accept the segment or bisect it
+  if(std::fabs(r.x - xh) <= tol){
+    samples.push_back(b);
+    return;
+  } // End if the error is below the tolerance
+  if(segments >= MaxSegments || !(pm > a.p && pm < b.p)){
+    throw "The requested accuracy of the root map could not be reached.";
+  } // End if the segment cannot be bisected
+
+  const RootSample m = {pm, r.x, tangent(f, r.x, pm)};
+  if(!std::isfinite(m.t)){
+    throw "The root map is not differentiable.";
+  } // End if the tangent is not finite
+  ++segments;
+  refine(f, solver, ws, a, m, tol, MaxSegments, segments, samples);
+  refine(f, solver, ws, m, b, tol, MaxSegments, segments, samples);
+}
+
+double RootMap::polish(const ParamFun &f, const double p, const size_t N, const size_t Strategy) const {
+  if(N == 0 || N+1 > HiSolveWorkspace::InlineSize || Strategy < 1 || Strategy > 4){
+    throw "The number of terms or the update strategy of the polishing step is not valid.";
+  } // End if N or Strategy is not valid
+
+  // Function value and derivatives at the approximate root
+  double buffer[HiSolveWorkspace::InlineSize];
+  const DfSpan df(buffer, N+1);
+  const double x = (*this)(p);
+  f.eval(x, p, N, df);
+  if(df[1] == 0.0 || !std::isfinite(df[0])){ return x; }
+
+  return x + hiSolveUpdate(Strategy, df, N);
+}
+
+size_t RootMap::build(const std::string &path, const ParamFun &f, const HiSolve &solver, const double x0, const double pmin, const double pmax, const double tol, const size_t MaxSegments){
+  if(!(pmax > pmin) || !(tol > 0.0) || MaxSegments == 0){
+    throw "The range, the accuracy, or the largest number of segments of the root map is not valid.";
+  } // End if the arguments are not valid
+
+  // Track the root across a coarse grid
+  const size_t n0 = MaxSegments < 8 ? MaxSegments : 8;
+  std::vector<double> grid(n0+1);
+  for(size_t i = 0; i != n0; ++i){ grid[i] = pmin + (pmax - pmin)*i/n0; }
+  grid[n0] = pmax;
+  const ContinuationResult tracked = HiSolveContinuation(solver).track(f, x0, grid);
+  if(!tracked.completed()){
+    throw "The root map could not be sampled.";
+  } // End if the branch was not tracked
+
+  std::vector<RootSample> coarse(n0+1);
+  for(size_t i = 0; i != n0+1; ++i){
+    coarse[i] = {grid[i], tracked.x[i], tangent(f, tracked.x[i], grid[i])};
+    if(!std::isfinite(coarse[i].t)){
+      throw "The root map is not differentiable.";
+    } // End if the tangent is not finite
+  } // End for i
+
+  // Bisect the segments until the estimated error is below the tolerance
+  HiSolveWorkspace ws;
+  std::vector<RootSample> samples(1, coarse[0]);
+  size_t segments = n0;
+  for(size_t i = 0; i != n0; ++i){ refine(f, solver, ws, coarse[i], coarse[i+1], tol, MaxSegments, segments, samples); }
+
+  // Normalized Taylor coefficients of the cubic Hermite interpolants at the left breakpoints
+  const size_t n = samples.size()-1;
+  std::vector<double> p(n+1), c(4*n);
+  for(size_t i = 0; i != n; ++i){
+    const RootSample &a = samples[i], &b = samples[i+1];
+    const double d = b.p - a.p;
+    const double s = (b.x - a.x)/d;
+    p[i]      = a.p;
+    c[4*i]    = a.x;
+    c[4*i+1]  = a.t;
+    c[4*i+2]  = (3.0*s - 2.0*a.t - b.t)/d;
+    c[4*i+3]  = (a.t + b.t - 2.0*s)/(d*d);
+  } // End for i
+  p[n] = samples[n].p;
+
+  TableFun::write(path, 3, p, c);
+
+  return n;
+}
@@ -25,34 +25,60 @@ SOFTWARE.
 // Class header
 #include <hi-solve.h>
 
-double HiSolve::solve(const Fun &f, const double x0){
-  // Copy the initial guess
-  double x = x0;
+// Wrapper of HiSolveEngine used for solving equations represented by a function object
+template<size_t Nmax, size_t Strategy, bool UseMaxOrder>
+struct FunEntry {
+  static SolveResult solve(const Fun &f, const DfSpan &df, const double x0, const double tol, const size_t maxit){
+    const auto eval = [&f](const double x, const size_t N, const DfSpan &df){ f.eval(x, N, df); };
+    const auto more = [&f](const double x, const size_t N0, const size_t N, const DfSpan &df){ f.evalMore(x, N0, N, df); };
+    return HiSolveEngine<Nmax, Strategy, UseMaxOrder>::solveStaged(eval, more, f.hasStagedEval(), df, x0, tol, maxit);
+  }
+};
 
-  // Evaluate the function and derivatives
-  f.eval(x, N(0), df);
+// Wrapper of HiSolveEngine used for solving equations represented by a function object while recording a trace
+template<size_t Nmax, size_t Strategy, bool UseMaxOrder>
+struct TracedFunEntry {
+  static SolveResult solve(const Fun &f, const DfSpan &df, const double x0, const double tol, const size_t maxit, HiSolveTrace &trace){
+    const auto eval = [&f](const double x, const size_t N, const DfSpan &df){ f.eval(x, N, df); };
+    const auto more = [&f](const double x, const size_t N0, const size_t N, const DfSpan &df){ f.evalMore(x, N0, N, df); };
+    return HiSolveEngine<Nmax, Strategy, UseMaxOrder>::solveStaged(eval, more, f.hasStagedEval(), df, x0, tol, maxit, trace);
+  }
+};
 
-  // Iterate until convergence or maximum number of iterations is reached
-  size_t  it = 0;
-  bool    Converged     = fabs(df[0]) < tol_;
-  bool    MaxItReached  = false;
-  while(!Converged && !MaxItReached){
-    // Increment the iteration counter
-    ++it;
+SolveResult HiSolve::solve(const Fun &f, const double x0, HiSolveWorkspace &ws) const {
+  // Function value and derivatives
+  ws.reserve(Nmax_);
+  const DfSpan df = ws.df(Nmax_);
 
-    // Compute update
-    const double dx = (this->*updateStrategy)(N(it));
+  // Iterate using the adaptive-order variant
+  const auto eval = [&f](const double x, const size_t N, const DfSpan &df){ f.eval(x, N, df); };
+  const auto more = [&f](const double x, const size_t N0, const size_t N, const DfSpan &df){ f.evalMore(x, N0, N, df); };
+  if(AdaptiveOrder_){ return iterateAdaptive(eval, more, f.hasStagedEval(), df, ws.work(Nmax_), x0); }
 
-    // Update approximation of solution
-    x += dx;
+  // Use a compile-time specialized engine if possible
+  if(Nmax_ > 0 && Nmax_ <= NmaxSpecialized){
+    return HiSolveDispatch<FunEntry, NmaxSpecialized>::lookup(Nmax_, UpdateStrategy_, UseMaxOrder_)(f, df, x0, tol_, maxit_);
+  } // End if Nmax_ <= NmaxSpecialized
 
-    // Evaluate the function and its derivatives
-    f.eval(x, Order(N(it)), df);
+  // Iterate using the update strategy chosen at run time
+  return iterate(eval, more, f.hasStagedEval(), df, ws.work(Nmax_), x0);
+}
+
+SolveResult HiSolve::solve(const Fun &f, const double x0, HiSolveWorkspace &ws, HiSolveTrace &trace) const {
+  // Function value and derivatives
+  ws.reserve(Nmax_);
+  const DfSpan df = ws.df(Nmax_);
+
+  // Iterate using the adaptive-order variant
+  const auto eval = [&f](const double x, const size_t N, const DfSpan &df){ f.eval(x, N, df); };
+  const auto more = [&f](const double x, const size_t N0, const size_t N, const DfSpan &df){ f.evalMore(x, N0, N, df); };
+  if(AdaptiveOrder_){ return iterateAdaptive(eval, more, f.hasStagedEval(), df, ws.work(Nmax_), x0, trace); }
 
-    // Check for convergence and whether the maximum number of iterations has been reached
-    Converged     = fabs(df[0]) < tol_;
-    MaxItReached  = it == maxit_;
-  } // End while not Converged and not MaxItReached
+  // Use the same compile-time specialized engine as the solve without a trace
+  if(Nmax_ > 0 && Nmax_ <= NmaxSpecialized){
+    return HiSolveDispatch<TracedFunEntry, NmaxSpecialized>::lookup(Nmax_, UpdateStrategy_, UseMaxOrder_)(f, df, x0, tol_, maxit_, trace);
+  } // End if Nmax_ <= NmaxSpecialized
 
-  return x;
+  // Iterate using the update strategy chosen at run time
+  return iterate(eval, more, f.hasStagedEval(), df, ws.work(Nmax_), x0, trace);
 }
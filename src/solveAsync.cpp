@@ -0,0 +1,155 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <hi-solve-async.h>
+
+// Standard library headers
+#include <algorithm> // For min
+#include <cmath> // For isfinite and fabs
+#include <deque> // For std::deque
+#include <exception> // For std::exception_ptr
+
+HiSolveResumable::HiSolveResumable(const HiSolve &solver) :
+  tol_(solver.getTol()), maxit_(solver.getMaxIt()), Nmax_(solver.getNmax()), UseMaxOrder_(solver.getUseMaxOrder()), Strategy_(solver.getUpdateStrategy()),
+  df_(solver.getNmax()+2), x_(0.0), it_(0), Avail_(0), done_(true) {
+  if(solver.getAdaptiveOrder()){
+    throw "The adaptive-order variant cannot be resumed.";
+  } // End if AdaptiveOrder
+}
+
+void HiSolveResumable::request(const AsyncFun &f){
+  // Order of the highest-order derivative (for the number of terms in the current iteration, as in hiSolveIterate)
+  const size_t N  = UseMaxOrder_ ? Nmax_ : std::min(it_, Nmax_);
+  Avail_          = UseMaxOrder_ ? N : N+1;
+
+  pending_ = f.evalAsync(x_, Avail_, DfSpan(df_.data(), Avail_+1));
+  ++result_.evaluations;
+  if(Avail_ > result_.order){ result_.order = Avail_; }
+}
+
+void HiSolveResumable::start(const AsyncFun &f, const double x0){
+  result_ = SolveResult();
+  x_      = x0;
+  it_     = 0;
+  done_   = false;
+  request(f);
+}
+
+bool HiSolveResumable::resume(const AsyncFun &f){
+  // Wait for the outstanding evaluation (rethrowing its exception)
+  done_ = true;
+  pending_.get();
+
+  // Check for termination
+  if(!std::isfinite(x_) || !std::isfinite(df_[0]))  { result_.status = SolveNonFinite; }
+  else if(std::fabs(df_[0]) < tol_)                 { result_.status = SolveConverged; }
+  else if(it_ == maxit_)                            { result_.status = SolveMaxIterations; }
+  else if(df_[1] == 0.0)                            { result_.status = SolveZeroDerivative; }
+  else{
+    // Compute update, update approximation of solution, and request the next evaluation
+    ++it_;
+    const size_t N = UseMaxOrder_ ? Nmax_ : std::min(it_, Nmax_);
+    x_    += hiSolveUpdate(Strategy_, df_, N);
+    done_  = false;
+    request(f);
+    return true;
+  } // End if termination
+
+  result_.x           = x_;
+  result_.f           = df_[0];
+  result_.iterations  = it_;
+
+  return false;
+}
+
+void HiSolveResumable::abandon(){
+  if(pending_.valid()){ pending_.wait(); }
+  pending_  = std::future<void>();
+  done_     = true;
+}
+
+constexpr std::chrono::microseconds HiSolveScheduler::PollInterval;
+
+size_t HiSolveScheduler::solve(const AsyncFun &f, const size_t n, const double *x0, SolveResult *results) const {
+  // Resumable solves, the problem solved by each of them, and the solves in flight (in the order of their requests)
+  std::vector<HiSolveResumable> solves;
+  for(size_t slot = 0; slot != std::min(n, MaxInFlight_); ++slot){ solves.emplace_back(solver_); }
+  std::vector<size_t>           problem(solves.size());
+  std::deque<size_t>            inflight;
+
+  size_t next = 0, converged = 0;
+  std::exception_ptr error;
+
+  // Start a new problem in a given slot (unless all problems have been started or an evaluation failed)
+  const auto launch = [&](const size_t slot){
+    if(next == n || error){ return; }
+    problem[slot] = next;
+    solves[slot].start(f, x0[next++]);
+    inflight.push_back(slot);
+  };
+  for(size_t slot = 0; slot != solves.size(); ++slot){ launch(slot); }
+
+  size_t turn = 0;
+  while(!inflight.empty()){
+    // Find a solve whose evaluation has completed (if none has, wait for a bounded time on the outstanding evaluations in turn)
+    auto pos = inflight.end();
+    while(pos == inflight.end()){
+      for(auto it = inflight.begin(); it != inflight.end(); ++it){
+        if(solves[*it].ready()){ pos = it; break; }
+      } // End for it
+      if(pos == inflight.end() && solves[inflight[turn++%inflight.size()]].ready(PollInterval)){
+        pos = inflight.begin() + (turn-1)%inflight.size();
+      } // End if none has completed
+    } // End while pos
+    const size_t slot = *pos;
+    inflight.erase(pos);
+
+    // Abandon the remaining solves if an evaluation failed
+    if(error){
+      solves[slot].abandon();
+      continue;
+    } // End if error
+
+    try{
+      if(solves[slot].resume(f)){
+        inflight.push_back(slot);
+        continue;
+      } // End if a new evaluation was requested
+    }
+    catch(...){
+      if(!error){ error = std::current_exception(); }
+      continue;
+    } // End try
+
+    // Store the result and start the next problem
+    results[problem[slot]] = solves[slot].result();
+    converged += solves[slot].result().converged();
+    launch(slot);
+  } // End while inflight
+
+  if(error){ std::rethrow_exception(error); }
+
+  return converged;
+}
@@ -0,0 +1,131 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <hi-solve.h>
+
+// Number of lanes solved together (chosen such that the workspace fits in the cache)
+static const size_t BlockSize = 512;
+
+size_t HiSolve::solveBatch(const Fun &f, const size_t n, const double *x0, double *x, bool *Converged) const {
+  // Workspace (the highest-order derivative used is Order(Nmax_))
+  std::vector<double> xa  (BlockSize);                     // Approximations for the active (unconverged) lanes
+  std::vector<double> dx  (BlockSize);                     // Updates
+  std::vector<double> aux (BlockSize);                     // Auxiliary workspace for the update strategies
+  std::vector<double> dfa ((Order(Nmax_) + 1)*BlockSize);  // Function values and derivatives in SoA layout
+  std::vector<size_t> idx (BlockSize);                     // Indices of the active lanes
+  std::vector<unsigned char> mask(BlockSize);              // Per-lane convergence mask
+
+  // Number of converged lanes
+  size_t nConverged = 0;
+
+  // Whether or not to use the staged protocol, i.e. only evaluate the derivatives of unconverged lanes (see Fun::evalMore)
+  const bool Staged = f.hasStagedEval();
+
+  for(size_t offset = 0; offset < n; offset += BlockSize){
+    // Number of active lanes in this block
+    size_t na = std::min(BlockSize, n - offset);
+
+    // Copy the initial guesses
+    for(size_t j = 0; j != na; ++j){
+      idx[j] = offset + j;
+      xa [j] = x0[offset + j];
+    } // End for j
+
+    // Evaluate the function (and the derivatives unless the staged protocol is used)
+    f.evalBatch(xa.data(), na, Staged ? 0 : Order(N(0)), dfa.data());
+
+    // Iterate until all lanes have converged or the maximum number of iterations is reached
+    size_t it = 0;
+    while(na > 0){
+      // Per-lane convergence mask
+      for(size_t j = 0; j != na; ++j){
+        mask[j] = std::fabs(dfa[j]) < tol_;
+      } // End for j
+
+      // Stop all remaining lanes if the maximum number of iterations has been reached
+      if(it == maxit_){
+        for(size_t j = 0; j != na; ++j){
+          x[idx[j]] = xa[j];
+          nConverged += mask[j];
+          if(Converged){ Converged[idx[j]] = mask[j]; }
+        } // End for j
+
+        break;
+      } // End if it == maxit_
+
+      // Increment the iteration counter
+      ++it;
+
+      // Retire converged lanes and evaluate the derivatives of the remaining lanes (staged protocol)
+      if(Staged){
+        size_t nb = 0;
+        for(size_t j = 0; j != na; ++j){
+          if(mask[j]){
+            x[idx[j]] = xa[j];
+            ++nConverged;
+            if(Converged){ Converged[idx[j]] = true; }
+          }
+          else{
+            idx [nb] = idx[j];
+            xa  [nb] = xa[j];
+            dfa [nb] = dfa[j];
+            mask[nb] = 0;
+            ++nb;
+          } // End if mask[j]
+        } // End for j
+        na = nb;
+
+        if(na == 0){ break; }
+        f.evalBatchMore(xa.data(), na, 0, Order(N(it-1)), dfa.data());
+      } // End if Staged
+
+      // Compute updates for all lanes (the updates of converged lanes are discarded)
+      (this->*updateStrategyBatch)(N(it), na, dfa.data(), dx.data(), aux.data());
+
+      // Retire converged lanes and update (and compact) the remaining lanes
+      size_t nb = 0;
+      for(size_t j = 0; j != na; ++j){
+        if(mask[j]){
+          x[idx[j]] = xa[j];
+          ++nConverged;
+          if(Converged){ Converged[idx[j]] = true; }
+        }
+        else{
+          idx[nb] = idx[j];
+          xa [nb] = xa[j] + dx[j];
+          ++nb;
+        } // End if mask[j]
+      } // End for j
+      na = nb;
+
+      // Evaluate the function and its derivatives for the remaining lanes
+      if(na > 0){
+        f.evalBatch(xa.data(), na, Staged ? 0 : Order(N(it)), dfa.data());
+      } // End if na > 0
+    } // End while na > 0
+  } // End for offset
+
+  return nConverged;
+}
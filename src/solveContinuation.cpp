@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <hi-solve-continuation.h>
+
+// Standard library headers
+#include <algorithm> // For min
+#include <cmath> // For fabs, sqrt, and isfinite
+#include <limits> // For numeric_limits
+
+// Cubic Hermite extrapolation of the points (p0, x0) and (p1, x1) with tangents t0 and t1 to the parameter value p
+static double hermite(const double p0, const double x0, const double t0, const double p1, const double x1, const double t1, const double p){
+  const double d  = p1 - p0;
+  const double s  = (p - p0)/d;
+  const double s2 = s*s;
+  const double s3 = s2*s;
+  return (2.0*s3 - 3.0*s2 + 1.0)*x0 + (s3 - 2.0*s2 + s)*d*t0 + (-2.0*s3 + 3.0*s2)*x1 + (s3 - s2)*d*t1;
+}
+
+ContinuationResult HiSolveContinuation::track(const ParamFun &f, const double x0, const std::vector<double> &p) const {
+  ContinuationResult result;
+  if(p.empty()){
+    result.status = ContinuationCompleted;
+    return result;
+  } // End if p is empty
+
+  // Workspace of the corrector and storage for the tangent
+  HiSolveWorkspace ws;
+  std::vector<double> df(2);
+  const double sqrteps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+  // Tangent of the branch (and the derivative with respect to x) at the root found by a solve (reusing the derivative of its last evaluation if available)
+  const auto tangent = [&](const SolveResult &r, const double q, double &fx){
+    if(r.df.size() > 1){
+      fx = r.df[1];
+    }
+    else{
+      f.eval(r.x, q, 1, df);
+      ++result.evaluations;
+      fx = df[1];
+    } // End if r.df.size() > 1
+    return -f.evalParam(r.x, q)/fx;
+  };
+
+  // The corrector gives up once the step would be rejected anyway
+  HiSolve corrector = solver_;
+  corrector.setMaxIt(std::min(MaxCorrections_, solver_.getMaxIt()));
+
+  // Root at the first parameter value
+  const SolveResult first = solver_.solve(FixedParamFun(f, p[0]), x0, ws);
+  result.iterations   += first.iterations;
+  result.evaluations  += first.evaluations;
+  result.p             = p[0];
+  result.xLast         = first.x;
+  if(!first.converged()){ return result; }
+
+  // The current point on the branch and the previous point (used by the predictor once hasPrev is true)
+  double pc = p[0], xc = first.x, fxc = 0.0;
+  double tc = tangent(first, pc, fxc);
+  double pp = pc, xp = xc, tp = tc;
+  bool hasPrev = false;
+  result.x.push_back(xc);
+  result.dxdp = tc;
+
+  // Step length (zero until the first step)
+  double h = 0.0;
+
+  for(size_t j = 1; j != p.size(); ++j){
+    while(pc != p[j]){
+      // Next parameter value (ending exactly at p[j])
+      const double dist = p[j] - pc;
+      if(h == 0.0){ h = std::fabs(dist); }
+      const double step = std::min(h, std::fabs(dist));
+      const double pn   = step == std::fabs(dist) ? p[j] : pc + (dist > 0.0 ? step : -step);
+
+      // Predict and correct
+      const double xpred = hasPrev ? hermite(pp, xp, tp, pc, xc, tc, pn) : xc + (pn - pc)*tc;
+      const SolveResult corr = corrector.solve(FixedParamFun(f, pn), xpred, ws);
+      result.iterations   += corr.iterations;
+      result.evaluations  += corr.evaluations;
+
+      // Accept the step if the corrector converged quickly to a point on the same branch
+      double fxn = 0.0, tn = 0.0;
+      bool accept = corr.converged();
+      if(accept){
+        tn      = tangent(corr, pn, fxn);
+        accept  = std::isfinite(tn) && (fxn > 0.0) == (fxc > 0.0)
+                  && std::fabs((corr.x - xc) - 0.5*(pn - pc)*(tc + tn)) <= 0.5*std::fabs(corr.x - xc) + sqrteps*(1.0 + std::fabs(corr.x));
+      } // End if accept
+
+      if(!accept){
+        ++result.rejected;
+        h = 0.5*step;
+        if(h < MinStep_){
+          result.status = hasPrev && std::fabs(tc) > std::fabs(tp) ? ContinuationTurningPoint : ContinuationBranchLost;
+          return result;
+        } // End if h < MinStep_
+        continue;
+      } // End if !accept
+
+      // Move along the branch and adapt the step length
+      pp = pc; xp = xc; tp = tc;
+      pc = pn; xc = corr.x; tc = tn; fxc = fxn;
+      hasPrev = true;
+      ++result.steps;
+      result.p      = pc;
+      result.xLast  = xc;
+      result.dxdp   = tc;
+      h = corr.iterations <= MaxCorrections_/2 ? 2.0*step : step;
+    } // End while pc != p[j]
+
+    result.x.push_back(xc);
+  } // End for j
+
+  result.status = ContinuationCompleted;
+
+  return result;
+}
@@ -0,0 +1,130 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard library headers
+#include <cfloat> // For DBL_EPSILON
+#include <cmath> // For cbrt
+#include <utility> // For std::swap
+
+// Class header
+#include <hi-solve.h>
+
+SolveResult HiSolve::solveDerivativeFree(const Fun &f, const double x0, HiSolveWorkspace &ws) const {
+  SolveResult result;
+
+  // Estimated function value and derivatives, iteration history (the newest approximate solution first), divided differences, and scratch values of update strategy 4
+  const size_t M = Nmax_ + 2;
+  ws.reserveValues(derivativeFreeWorkspaceSize());
+  const DfSpan  w  = ws.values(derivativeFreeWorkspaceSize());
+  const DfSpan  df(w.data(), M);
+  double        *z  = w.data() +   M;
+  double        *fz = w.data() + 2*M;
+  double        *c  = w.data() + 3*M;
+  double        *pw = w.data() + 4*M;
+
+  // Evaluate the function at the initial guess and at the perturbed initial guess
+  z[1] = x0;
+  f.eval(z[1], 0, df);
+  fz[1] = df[0];
+  z[0] = x0 + std::cbrt(DBL_EPSILON)*std::max(1.0, std::fabs(x0));
+  f.eval(z[0], 0, df);
+  fz[0] = df[0];
+  result.evaluations = 2;
+
+  // Start from the initial guess if the function value is smaller there
+  if(std::fabs(fz[1]) < std::fabs(fz[0]) || !std::isfinite(fz[0])){
+    std::swap(z[0], z[1]);
+    std::swap(fz[0], fz[1]);
+  } // End if the initial guess is better
+  df[0] = fz[0];
+
+  // Number of points in the history (and the largest number used)
+  size_t        m     = 2;
+  const size_t  mmax  = std::max(Nmax_, size_t(1)) + 1;
+  size_t        it    = 0;
+
+  // Iterate until termination
+  while(true){
+    // Check for termination
+    const double x = z[0];
+    if(!std::isfinite(x) || !std::isfinite(df[0])){ result.status = SolveNonFinite;     break; }
+    if(std::fabs(df[0]) < tol_)                   { result.status = SolveConverged;     break; }
+    if(it == maxit_)                              { result.status = SolveMaxIterations; break; }
+
+    // Newton divided differences, c[j] = f[z[0], ..., z[j]]
+    for(size_t i = 0; i != m; ++i){ c[i] = fz[i]; }
+    for(size_t j = 1; j != m; ++j){
+      for(size_t i = m-1; i >= j; --i){
+        c[i] = (c[i] - c[i-1])/(z[i] - z[i-j]);
+      } // End for i
+    } // End for j
+
+    // Taylor coefficients of the interpolating polynomial around x (Horner's scheme for the Newton form in the shifted variable)
+    const size_t Nm = m-1;
+    for(size_t k = 0; k != Nm+1; ++k){ df[k] = 0.0; }
+    df[0] = c[Nm];
+    for(size_t j = Nm; j-- != 0;){
+      const double d = x - z[j];
+      for(size_t k = Nm-j; k != 0; --k){
+        df[k] = df[k-1] + d*df[k];
+      } // End for k
+      df[0] = d*df[0] + c[j];
+    } // End for j
+
+    // Convert to derivatives
+    double fac = 1.0;
+    for(size_t k = 2; k <= Nm; ++k){
+      fac   *= k;
+      df[k] *= fac;
+    } // End for k
+
+    // Compute the high-order update (unless the estimated first-order derivative is zero or not finite)
+    if(df[1] == 0.0)                              { result.status = SolveZeroDerivative; break; }
+    const double xn = x + (this->*updateStrategy)(df.data(), Nm, pw);
+    if(!std::isfinite(xn))                        { result.status = SolveNonFinite;     break; }
+    if(std::fabs(xn - x) <= DBL_EPSILON*std::fabs(x)){ result.status = SolveStagnated;  break; }
+
+    // Increment the iteration counter and evaluate the function at the new approximate solution
+    ++it;
+    f.eval(xn, 0, df);
+    ++result.evaluations;
+
+    // Update the iteration history (only the last Nmax+1 points are used)
+    m = std::min(m+1, mmax);
+    for(size_t i = m-1; i != 0; --i){
+      z[i]  = z[i-1];
+      fz[i] = fz[i-1];
+    } // End for i
+    z[0]  = xn;
+    fz[0] = df[0];
+  } // End while true
+
+  result.x          = z[0];
+  result.f          = fz[0];
+  result.df         = DfSpan(df.data(), 1);
+  result.iterations = it;
+  df[0]             = fz[0];
+
+  return result;
+}
@@ -0,0 +1,151 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard library headers
+#include <cfloat> // For DBL_EPSILON
+#include <limits> // For infinity and quiet_NaN
+#include <utility> // For std::swap
+
+// Class header
+#include <hi-solve.h>
+
+SolveResult HiSolve::iterateSafeguarded(const Fun &f, const double x0, double a, double b, const bool Bracketed, HiSolveWorkspace &ws) const {
+  SolveResult result;
+
+  // Function value and derivatives, and scratch values of update strategy 4
+  ws.reserve(Nmax_);
+  const DfSpan df   = ws.df(Nmax_);
+  double      *work = ws.work(Nmax_);
+
+  // Copy the initial guess
+  double x = x0;
+
+  // Function values at the ends of the bracket
+  double fa = 0.0;
+  double fb = 0.0;
+  if(Bracketed){
+    if(a > b){ std::swap(a, b); }
+
+    f.eval(a, 0, df); fa = df[0];
+    f.eval(b, 0, df); fb = df[0];
+    result.evaluations = 2;
+
+    // The function must be finite and change sign in the bracket
+    const bool Finite = std::isfinite(fa) && std::isfinite(fb);
+    if(!Finite || (fa < 0.0) == (fb < 0.0)){
+      result.x      = std::fabs(fa) < std::fabs(fb) ? a : b;
+      result.f      = std::fabs(fa) < std::fabs(fb) ? fa : fb;
+      result.df     = DfSpan(df.data(), 1);
+      result.status = Finite ? SolveNoSignChange : SolveNonFinite;
+      df[0]         = result.f;
+
+      // Unless one of the ends is a solution
+      if(!Finite || std::fabs(result.f) >= tol_){ return result; }
+    } // End if no sign change
+
+    // Start from the ends of the bracket if they are solutions, and otherwise from the midpoint if x0 is not inside the bracket
+    if     (std::fabs(fa) < tol_){ x = a; }
+    else if(std::fabs(fb) < tol_){ x = b; }
+    else if(!(x > a && x < b))   { x = 0.5*(a + b); }
+  } // End if Bracketed
+
+  // Evaluate the function (and the derivatives needed in the first iteration unless the staged protocol is used)
+  const bool Staged = f.hasStagedEval();
+  size_t it     = 0;
+  size_t Order0 = Order(N(0));
+  size_t Avail  = Staged ? 0 : Order0;
+  f.eval(x, Avail, df);
+  ++result.evaluations;
+  result.order = Avail;
+
+  // Absolute value of the function in the previous iteration, number of consecutive iterations in which it did not decrease, and width of the bracket in the previous two iterations
+  double  res     = std::numeric_limits<double>::infinity();
+  size_t  Growth  = 0;
+  double  w1      = std::numeric_limits<double>::infinity();
+  double  w2      = std::numeric_limits<double>::infinity();
+
+  // Iterate until termination
+  while(true){
+    // Check for termination
+    if(!std::isfinite(x) || !std::isfinite(df[0])){ result.status = SolveNonFinite;     break; }
+    if(std::fabs(df[0]) < tol_)                   { result.status = SolveConverged;     break; }
+    if(it == maxit_)                              { result.status = SolveMaxIterations; break; }
+
+    if(Bracketed){
+      // Shrink the bracket
+      if((df[0] < 0.0) == (fa < 0.0)){ a = x; fa = df[0]; }
+      else                           { b = x; fb = df[0]; }
+
+      // The bracket cannot be shrunk further
+      if(b - a <= 4.0*DBL_EPSILON*std::max(std::fabs(a), std::fabs(b))){ result.status = SolveStagnated; break; }
+    }
+    else{
+      // The absolute value of the function must decrease
+      Growth = std::fabs(df[0]) >= res ? Growth+1 : 0;
+      if(Growth == 2){ result.status = SolveDiverged; break; }
+    } // End if Bracketed
+    res = std::fabs(df[0]);
+
+    // Evaluate the derivatives needed for the update
+    if(Avail < Order0){
+      f.evalMore(x, Avail, Order0, df);
+      Avail         = Order0;
+      result.order  = std::max(result.order, Order0);
+    } // End if Avail < Order0
+
+    // Compute the high-order update (unless the first-order derivative is zero or not finite)
+    const bool Update = df[1] != 0.0 && std::isfinite(df[1]);
+    double xn = Update ? x + (this->*updateStrategy)(df.data(), N(it+1), work) : std::numeric_limits<double>::quiet_NaN();
+
+    if(Bracketed){
+      // Take a bisection step unless the high-order update stays inside the bracket and the bracket has been halved within the last two iterations
+      if(!(xn > a && xn < b) || b - a > 0.5*w2){ xn = 0.5*(a + b); }
+      w2 = w1;
+      w1 = b - a;
+    }
+    else{
+      if(!Update)               { result.status = df[1] == 0.0 ? SolveZeroDerivative : SolveNonFinite; break; }
+      if(!std::isfinite(xn))    { result.status = SolveNonFinite; break; }
+      if(std::fabs(xn - x) <= DBL_EPSILON*std::fabs(x)){ result.status = SolveStagnated; break; }
+    } // End if Bracketed
+
+    // Increment the iteration counter and update approximation of solution
+    ++it;
+    x = xn;
+
+    // Evaluate the function and its derivatives
+    Order0 = Order(N(it));
+    Avail  = Staged ? 0 : Order0;
+    f.eval(x, Avail, df);
+    ++result.evaluations;
+    result.order = std::max(result.order, Avail);
+  } // End while true
+
+  result.x          = x;
+  result.f          = df[0];
+  result.df         = DfSpan(df.data(), Avail+1);
+  result.iterations = it;
+
+  return result;
+}
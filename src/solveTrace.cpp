@@ -0,0 +1,92 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <hi-solve-trace.h>
+
+// Standard library headers
+#include <cfloat> // For DBL_EPSILON
+#include <cmath> // For log, log10, and isfinite
+#include <limits> // For quiet_NaN and max_digits10
+
+double HiSolveTrace::orderOfConvergence() const {
+  // Updates of the most recent solve held which are not dominated by rounding errors (newest first)
+  double e[3];
+  size_t m = 0;
+  const size_t n = size();
+  for(size_t i = n; i-- != 0 && m != 3;){
+    const HiSolveTraceRecord &r = (*this)[i];
+    if(r.solve != (*this)[n-1].solve){ break; }
+
+    const double dx = std::fabs(r.dx);
+    if(std::isfinite(dx) && dx > 4.0*DBL_EPSILON*std::fabs(r.x)){ e[m++] = dx; }
+  } // End for i
+
+  if(m != 3 || e[0] == e[1] || e[1] == e[2]){ return std::numeric_limits<double>::quiet_NaN(); }
+  return std::log(e[0]/e[1])/std::log(e[1]/e[2]);
+}
+
+// Write a number to a JSON document (non-finite numbers are written as null)
+static void writeNumber(std::ostream &out, const double v){
+  if(std::isfinite(v)){ out << v; } else{ out << "null"; }
+}
+
+void HiSolveTrace::writeChromeTrace(std::ostream &out) const {
+  const std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+  out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  for(size_t i = 0; i != size(); ++i){
+    const HiSolveTraceRecord &r = (*this)[i];
+
+    // The iteration (times in microseconds)
+    out << (i == 0 ? "\n" : ",\n");
+    out << "  {\"name\": \"iteration " << r.iteration << "\", \"cat\": \"hisolve\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << r.solve;
+    out << ", \"ts\": ";  writeNumber(out, 1.0e6*r.start);
+    out << ", \"dur\": "; writeNumber(out, 1.0e6*r.duration);
+    out << ", \"args\": {\"x\": "; writeNumber(out, r.x);
+    out << ", \"f\": ";           writeNumber(out, r.f);
+    out << ", \"dx\": ";          writeNumber(out, r.dx);
+    out << ", \"order\": " << r.order << ", \"terms\": " << r.terms << ", \"corrections\": [";
+    for(size_t k = 0; k != r.corrections; ++k){
+      if(k != 0){ out << ", "; }
+      writeNumber(out, r.correction[k]);
+    } // End for k
+    out << "]}},\n";
+
+    // The evaluation of the function and its derivatives
+    out << "  {\"name\": \"eval\", \"cat\": \"hisolve\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << r.solve;
+    out << ", \"ts\": ";  writeNumber(out, 1.0e6*r.start);
+    out << ", \"dur\": "; writeNumber(out, 1.0e6*r.evalTime);
+    out << ", \"args\": {\"order\": " << r.order << "}},\n";
+
+    // The residual
+    out << "  {\"name\": \"log10|f|\", \"cat\": \"hisolve\", \"ph\": \"C\", \"pid\": 1, \"tid\": " << r.solve;
+    out << ", \"ts\": ";  writeNumber(out, 1.0e6*r.start);
+    out << ", \"args\": {\"solve " << r.solve << "\": "; writeNumber(out, std::log10(std::fabs(r.f)));
+    out << "}}";
+  } // End for i
+  out << "\n]}\n";
+
+  out.precision(precision);
+}
@@ -0,0 +1,183 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <hi-solve-tuner.h>
+
+// Standard library headers
+#include <cctype> // For isspace
+#include <chrono> // For steady_clock
+#include <cstdio> // For rename and remove
+#include <fstream> // For ifstream and ofstream
+#include <sstream> // For istringstream
+
+// First line of a tuning cache
+static const char *CacheHeader = "# hi-solve tuning cache 1";
+
+HiSolveTuning HiSolveTuner::measure(const HiSolveTuning &tuning, const std::vector<Problem> &problems) const {
+  const HiSolve solver = this->solver(tuning);
+  HiSolveWorkspace ws;
+
+  // Evaluations and failures (from the first repetition)
+  size_t evaluations = 0, failures = 0;
+  for(const Problem &problem : problems){
+    const SolveResult result = solver.solve(*problem.first, problem.second, ws);
+    evaluations += result.evaluations;
+    failures    += !result.converged();
+  } // End for problem
+
+  // Wall time
+  const auto start = std::chrono::steady_clock::now();
+  for(size_t rep = 0; rep != repetitions_; ++rep){
+    for(const Problem &problem : problems){ solver.solve(*problem.first, problem.second, ws); }
+  } // End for rep
+  const auto stop = std::chrono::steady_clock::now();
+
+  const double solves = double(repetitions_)*problems.size();
+
+  HiSolveTuning measured  = tuning;
+  measured.ns             = std::chrono::duration<double, std::nano>(stop - start).count()/solves;
+  measured.evaluations    = double(evaluations)/problems.size();
+  measured.failures       = double(failures)/problems.size();
+
+  return measured;
+}
+
+HiSolveTuning HiSolveTuner::calibrate(const std::vector<Problem> &problems) const {
+  if(problems.empty()){
+    throw "There must be at least one sample problem.";
+  } // End if problems is empty
+
+  HiSolveTuning best;
+  bool found = false;
+
+  for(const size_t Nmax : NmaxCandidates_){
+    for(size_t strat = 1; strat != 5; ++strat){
+      for(int UseMaxOrder = 1; UseMaxOrder >= 0; --UseMaxOrder){
+        // Nmax = 1 is Newton's method regardless of the strategy and variant
+        if(Nmax == 1 && (strat != 1 || !UseMaxOrder)){ continue; }
+
+        HiSolveTuning tuning;
+        tuning.Nmax           = Nmax;
+        tuning.UpdateStrategy = strat;
+        tuning.UseMaxOrder    = UseMaxOrder;
+        const HiSolveTuning measured = measure(tuning, problems);
+
+        // Prefer reliable configurations, then the fastest (or the least unreliable)
+        const bool reliable     = measured.failures <= MaxFailureRate_;
+        const bool bestReliable = found && best.failures <= MaxFailureRate_;
+        bool better;
+        if(!found){
+          better = true;
+        }
+        else if(reliable != bestReliable){
+          better = reliable;
+        }
+        else if(reliable){
+          better = measured.ns < best.ns;
+        }
+        else{
+          better = measured.failures < best.failures || (measured.failures == best.failures && measured.ns < best.ns);
+        } // End if found
+
+        if(better){
+          best  = measured;
+          found = true;
+        } // End if better
+      } // End for UseMaxOrder
+    } // End for strat
+  } // End for Nmax
+
+  return best;
+}
+
+HiSolve HiSolveTuner::tune(const std::string &cache, const std::string &family, const std::vector<Problem> &problems) const {
+  HiSolveTuning tuning;
+  if(!load(cache, family, tuning)){
+    tuning = calibrate(problems);
+    save(cache, family, tuning);
+  } // End if the family is not in the cache
+
+  return solver(tuning);
+}
+
+bool HiSolveTuner::load(const std::string &cache, const std::string &family, HiSolveTuning &tuning){
+  std::ifstream file(cache);
+  std::string line;
+  if(!file || !std::getline(file, line) || line != CacheHeader){ return false; }
+
+  while(std::getline(file, line)){
+    std::istringstream fields(line);
+    std::string name;
+    HiSolveTuning entry;
+    if(!(fields >> name) || name != family){ continue; }
+    if(!(fields >> entry.Nmax >> entry.UpdateStrategy >> entry.UseMaxOrder >> entry.ns >> entry.evaluations >> entry.failures)){
+      throw "The tuning cache is not valid.";
+    } // End if the entry cannot be read
+    if(entry.Nmax == 0 || entry.UpdateStrategy < 1 || entry.UpdateStrategy > 4){
+      throw "The tuning cache is not valid.";
+    } // End if the entry is not a valid configuration
+
+    tuning = entry;
+    return true;
+  } // End while getline
+
+  return false;
+}
+
+void HiSolveTuner::save(const std::string &cache, const std::string &family, const HiSolveTuning &tuning){
+  bool valid = !family.empty();
+  for(const char c : family){ valid = valid && !std::isspace(static_cast<unsigned char>(c)); }
+  if(!valid){
+    throw "The identifier of the family must be nonempty and must not contain whitespace.";
+  } // End if family is not valid
+
+  // Keep the entries of the other families
+  std::vector<std::string> lines;
+  std::ifstream in(cache);
+  std::string line;
+  if(in && std::getline(in, line) && line == CacheHeader){
+    while(std::getline(in, line)){
+      std::istringstream fields(line);
+      std::string name;
+      if((fields >> name) && name != family){ lines.push_back(line); }
+    } // End while getline
+  } // End if the cache exists
+  in.close();
+
+  // Write to a temporary file and rename it such that readers never see a partial cache
+  const std::string tmp = cache + ".tmp";
+  std::ofstream out(tmp, std::ios::trunc);
+  out.precision(17);
+  out << CacheHeader << '\n';
+  for(const std::string &other : lines){ out << other << '\n'; }
+  out << family << ' ' << tuning.Nmax << ' ' << tuning.UpdateStrategy << ' ' << tuning.UseMaxOrder << ' '
+      << tuning.ns << ' ' << tuning.evaluations << ' ' << tuning.failures << '\n';
+  out.close();
+
+  if(!out || std::rename(tmp.c_str(), cache.c_str()) != 0){
+    std::remove(tmp.c_str());
+    throw "Unable to write the tuning cache.";
+  } // End if the cache could not be written
+}
@@ -0,0 +1,223 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <table-fun.h>
+
+// Standard library headers
+#include <algorithm> // For min, max, and upper_bound
+#include <cstdio> // For rename and remove
+#include <cstring> // For memcmp
+#include <fstream> // For ofstream
+
+// POSIX headers (memory mapping)
+#include <fcntl.h> // For open
+#include <sys/mman.h> // For mmap and munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h> // For close
+
+// Magic number identifying a table, size of the header, and kinds of grids
+static const char     Magic[8]    = {'H', 'S', 'T', 'A', 'B', 'L', 'E', '1'};
+static const size_t   HeaderSize  = 48;
+static const uint64_t Uniform     = 0;
+static const uint64_t Nonuniform  = 1;
+
+TableFun::TableFun(const std::string &path) : map_(nullptr), bytes_(0), x_(nullptr) {
+  // Map the file
+  const int fd = open(path.c_str(), O_RDONLY);
+  if(fd < 0){
+    throw "Unable to open the table.";
+  } // End if fd < 0
+
+  struct stat st;
+  if(fstat(fd, &st) != 0 || size_t(st.st_size) < HeaderSize){
+    close(fd);
+    throw "The table is not valid.";
+  } // End if the file is too small
+
+  bytes_  = st.st_size;
+  map_    = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(map_ == MAP_FAILED){
+    throw "Unable to map the table.";
+  } // End if map_ failed
+
+  // Read the header
+  const char      *bytes  = static_cast<const char*>(map_);
+  const uint64_t  *words  = reinterpret_cast<const uint64_t*>(map_);
+  const double    *values = reinterpret_cast<const double*>(map_);
+  const uint64_t  kind    = words[3];
+  m_  = words[1];
+  n_  = words[2];
+  x0_ = values[4];
+  h_  = values[5];
+  rh_ = 1.0/h_;
+
+  // The size of the file must match the header (the number of segments and coefficients are bounded by the size before multiplying them)
+  const size_t Words  = (bytes_ - HeaderSize)/8;
+  const bool   Valid  = std::memcmp(bytes, Magic, 8) == 0 && (kind == Uniform || kind == Nonuniform) && (kind == Nonuniform || h_ > 0.0)
+                     && n_ > 0 && m_ < Words && m_+1 <= Words/n_
+                     && (kind == Uniform ? 0 : n_+1) + n_*(m_+1) == Words && (bytes_ - HeaderSize)%8 == 0;
+  if(!Valid){
+    munmap(map_, bytes_);
+    throw "The table is not valid.";
+  } // End if not Valid
+
+  // Breakpoints and coefficients
+  x_ = kind == Nonuniform ? values + HeaderSize/8 : nullptr;
+  c_ = values + HeaderSize/8 + (x_ ? n_+1 : 0);
+
+  // Table of factorials
+  fac_.resize(m_+1);
+  fac_[0] = 1.0;
+  for(size_t k = 1; k != fac_.size(); ++k){
+    fac_[k] = k*fac_[k-1];
+  } // End for k
+}
+
+TableFun::~TableFun(){
+  munmap(map_, bytes_);
+}
+
+size_t TableFun::segment(const double x) const {
+  // Nonuniform grids (binary search for the first of the interior breakpoints x_1, ..., x_{n-1} which is larger than x)
+  if(x_){
+    return std::upper_bound(x_+1, x_+n_, x) - (x_+1);
+  } // End if x_
+
+  // Uniform grids (also handles NaN)
+  const double t = (x - x0_)*rh_;
+  if(!(t >= 0.0)){ return 0;    }
+  if(t >= n_)    { return n_-1; }
+  return size_t(t);
+}
+
+void TableFun::eval(const double x, const size_t N, DfSpan df) const {
+  // Coefficients and local variable of the segment
+  const size_t  i   = segment(x);
+  const double  *c  = c_ + i*(m_+1);
+  const double  t   = x - breakpoint(i);
+  const size_t  Nm  = std::min(N, m_);
+
+  // Repeated synthetic division (the extended Horner scheme)
+  df[0] = c[m_];
+  for(size_t k = 1; k != N+1; ++k){
+    df[k] = 0.0;
+  } // End for k
+  for(size_t j = m_; j-- != 0;){
+    for(size_t k = std::min(Nm, m_-j); k != 0; --k){
+      df[k] = df[k]*t + df[k-1];
+    } // End for k
+    df[0] = df[0]*t + c[j];
+  } // End for j
+
+  // Convert to derivatives
+  for(size_t k = 2; k <= Nm; ++k){
+    df[k] *= fac_[k];
+  } // End for k
+}
+
+// Write the header, the breakpoints (nonuniform grids), and the coefficients of a table (to a temporary file which replaces the table, such that existing mappings of the table are not truncated)
+static void writeTable(const std::string &path, const uint64_t m, const uint64_t n, const uint64_t kind, const double x0, const double h, const std::vector<double> &x, const std::vector<double> &c){
+  const std::string tmp = path + ".tmp";
+  std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+  file.write(Magic, 8);
+  file.write(reinterpret_cast<const char*>(&m),     8);
+  file.write(reinterpret_cast<const char*>(&n),     8);
+  file.write(reinterpret_cast<const char*>(&kind),  8);
+  file.write(reinterpret_cast<const char*>(&x0),    8);
+  file.write(reinterpret_cast<const char*>(&h),     8);
+  file.write(reinterpret_cast<const char*>(x.data()), 8*x.size());
+  file.write(reinterpret_cast<const char*>(c.data()), 8*c.size());
+  file.close();
+
+  if(!file || std::rename(tmp.c_str(), path.c_str()) != 0){
+    std::remove(tmp.c_str());
+    throw "Unable to write the table.";
+  } // End if not written
+}
+
+void TableFun::write(const std::string &path, const size_t m, const double x0, const double h, const std::vector<double> &c){
+  if(c.empty() || c.size()%(m+1) != 0 || !(h > 0.0)){
+    throw "The coefficients or the grid of the table are not valid.";
+  } // End if not valid
+
+  writeTable(path, m, c.size()/(m+1), Uniform, x0, h, std::vector<double>(), c);
+}
+
+void TableFun::write(const std::string &path, const size_t m, const std::vector<double> &x, const std::vector<double> &c){
+  bool Increasing = x.size() > 1;
+  for(size_t i = 1; i < x.size(); ++i){
+    Increasing = Increasing && x[i] > x[i-1];
+  } // End for i
+
+  if(!Increasing || c.size() != (x.size()-1)*(m+1)){
+    throw "The coefficients or the grid of the table are not valid.";
+  } // End if not valid
+
+  writeTable(path, m, x.size()-1, Nonuniform, x[0], 0.0, x, c);
+}
+
+void TableFun::writeInterpolant(const std::string &path, const size_t m, const double x0, const double h, const std::vector<double> &y){
+  // Number of segments
+  const size_t n = y.size() - 1;
+  if(y.size() < 2 || m == 0 || m > n || !(h > 0.0)){
+    throw "The data or the degree of the table are not valid.";
+  } // End if not valid
+
+  std::vector<double> c(n*(m+1));
+  std::vector<double> d(m+1);
+  for(size_t i = 0; i != n; ++i){
+    // The m+1 grid points closest to the segment (s, s+1, ..., s+m)
+    const size_t s = std::min(i - std::min(i, (m-1)/2), n-m);
+
+    // Newton divided differences in the scaled local variable u = (x - x_i)/h (the grid points are u = s+j-i)
+    for(size_t j = 0; j != m+1; ++j){ d[j] = y[s+j]; }
+    for(size_t k = 1; k <= m; ++k){
+      for(size_t j = m; j >= k; --j){
+        d[j] = (d[j] - d[j-1])/k;
+      } // End for j
+    } // End for k
+
+    // Coefficients of the powers of u (Horner's scheme for the Newton form)
+    double *ci = c.data() + i*(m+1);
+    ci[0] = d[m];
+    for(size_t j = m; j-- != 0;){
+      const double a = double(i) - double(s+j);
+      for(size_t k = m-j; k != 0; --k){
+        ci[k] = ci[k-1] + a*ci[k];
+      } // End for k
+      ci[0] = a*ci[0] + d[j];
+    } // End for j
+
+    // Coefficients of the powers of x - x_i
+    double rhk = 1.0;
+    for(size_t k = 1; k <= m; ++k){
+      rhk   /= h;
+      ci[k] *= rhk;
+    } // End for k
+  } // End for i
+
+  writeTable(path, m, n, Uniform, x0, h, std::vector<double>(), c);
+}
@@ -25,65 +25,22 @@ SOFTWARE.
 // Class header
 #include <hi-solve.h>
 
-double HiSolve::updateStrategy1(const size_t N) const {
-  // Newton-step
-  double dx = -df[0]/df[1];
-
-  // Modify Newton-step using higher-order derivatives
-  for(int k = 1; k != N; ++k){
-    // Auxiliary variables
-    double den = 0.0;
-    double aux = 1.0;
-    double fac = 1.0;
-
-    // Update Newton-step
-    for(int l = 0; l != k; l++){
-      fac *= l;
-      den += aux*df[l+1]/fac;
-      aux *= dx;
-    } // End for l
-  } // End for k
-
-  return dx;
+double HiSolve::updateStrategy1(const double *df, const size_t N, double*) const {
+  // Newton-step (the higher-order terms are not used by strategy 1)
+  return hiSolveTaylorUpdate(1, df, N);
 }
 
-double HiSolve::updateStrategy2(const size_t N) const {
-  // Auxiliary variables
-  double fac = 1.0;
-
-  // Newton-step
-  double dx = -df[0]/df[1];
-
-  // Modify Newton-step using higher-order derivatives
-  for(int k = 1; k != N; ++k){
-    // Update auxiliary factors
-    const double aux = std::pow(dx, k);
-    fac *= k+1;
-
-    // Update Newton-step
-    dx = 1.0/(1.0/dx - aux*df[k+1]/(fac*df[0]));
-  } // End for k
-
-  return dx;
+double HiSolve::updateStrategy2(const double *df, const size_t N, double*) const {
+  // Shared kernel, i.e. the same arithmetic as in HiSolveEngine
+  return hiSolveTaylorUpdate(2, df, N);
 }
 
-double HiSolve::updateStrategy3(const size_t N) const {
-  // Auxiliary variables
-  double aux = 1.0;
-  double fac = 1.0;
-
-  // Newton-step
-  double dx = -df[0]/df[1];
-
-  // Modify Newton-step using higher-order derivatives
-  for(int k = 1; k != N; ++k){
-    // Update auxiliary factors
-    aux *= dx;
-    fac *= k+1;
-
-    // Update Newton-step
-    dx = 1.0/(1.0/dx - aux*df[k+1]/(fac*df[0]));
-  } // End for k
+double HiSolve::updateStrategy3(const double *df, const size_t N, double*) const {
+  // Shared kernel, i.e. the same arithmetic as in HiSolveEngine
+  return hiSolveTaylorUpdate(3, df, N);
+}
 
-  return dx;
+double HiSolve::updateStrategy4(const double *df, const size_t N, double *work) const {
+  // Root of the Pade approximant (using the scratch values in the workspace, i.e. no memory is allocated on the heap)
+  return hiSolvePadeUpdate(df, N, work);
 }
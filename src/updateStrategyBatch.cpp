@@ -0,0 +1,46 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Class header
+#include <hi-solve.h>
+
+void HiSolve::updateStrategyBatch1(const size_t N, const size_t n, const double *df, double *dx, double *aux) const {
+  // Newton-step (the higher-order terms are not used by strategy 1, see updateStrategy1)
+  hiSolveUpdateBatch(1, N, n, df, dx, aux);
+}
+
+void HiSolve::updateStrategyBatch2(const size_t N, const size_t n, const double *df, double *dx, double *aux) const {
+  // Shared kernel, i.e. the same arithmetic as in the batched mixed-precision variant
+  hiSolveUpdateBatch(2, N, n, df, dx, aux);
+}
+
+void HiSolve::updateStrategyBatch3(const size_t N, const size_t n, const double *df, double *dx, double *aux) const {
+  // Shared kernel, i.e. the same arithmetic as in the batched mixed-precision variant
+  hiSolveUpdateBatch(3, N, n, df, dx, aux);
+}
+
+void HiSolve::updateStrategyBatch4(const size_t N, const size_t n, const double *df, double *dx, double *aux) const {
+  // Root of the Pade approximant (the lanes are processed one by one)
+  hiSolveUpdateBatch(4, N, n, df, dx, aux);
+}
@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For pow
+#include <vector> // For std::vector
+
+// The library being tested
+#include <batch-driver.h>
+#include <poly-fun.h>
+
+/// Test the parallel batch driver
+
+int main(int argc, char **argv){
+  // Polynomial from example_poly (the number of iterations varies a lot with the initial guess)
+  const int m = 31;
+  std::vector<double> a(m, 0.0);
+  for(int i = 1; i != m; ++i){
+    a[i] = pow(10.0, -i);
+  } // End for i
+  const PolyFun q(a);
+
+  // Solver
+  const HiSolve solver(1.0e-14, 40, 5, true, 3);
+
+  // Grid of initial guesses
+  const size_t n = 5000;
+  std::vector<double> x0(n), xref(n), x(n);
+  for(size_t i = 0; i != n; ++i){
+    x0[i] = -20.0 + 40.0*i/n;
+  } // End for i
+
+  // Reference solution computed sequentially
+  for(size_t i = 0; i != n; ++i){
+    xref[i] = solver.solve(q, x0[i]);
+  } // End for i
+
+  for(size_t nthreads = 1; nthreads < 6; nthreads += 2){
+    BatchDriver driver(solver, nthreads, 4);
+    if(driver.getNumThreads() != nthreads){ return EXIT_FAILURE; }
+
+    // Solve twice with the same driver
+    for(int rep = 0; rep != 2; ++rep){
+      driver.solve(q, n, x0.data(), x.data());
+
+      // The results must be bit-identical to the sequential results
+      for(size_t i = 0; i != n; ++i){
+        if(!(x[i] == xref[i]) && !(x[i] != x[i] && xref[i] != xref[i])){ return EXIT_FAILURE; }
+      } // End for i
+
+      // Every problem must be solved exactly once
+      size_t problems = 0;
+      for(const BatchDriverStats &s : driver.getStats()){
+        problems += s.problems;
+        if(s.problems > 0 && s.chunks == 0){ return EXIT_FAILURE; }
+      } // End for s
+      if(problems != n){ return EXIT_FAILURE; }
+    } // End for rep
+  } // End for nthreads
+
+  // Exceptions thrown by a task are rethrown by run
+  BatchDriver driver(solver, 3);
+  bool RunRethrows = false;
+  try{
+    driver.run(100, [](const size_t begin, const size_t end, HiSolveWorkspace &ws){
+      if(begin <= 50 && 50 < end){ throw "Failure in problem 50"; }
+    });
+  } catch(const char* msg) {
+    RunRethrows = true;
+  }
+
+  if(!RunRethrows){ return EXIT_FAILURE; }
+
+  // An empty batch does nothing
+  driver.run(0, [](const size_t begin, const size_t end, HiSolveWorkspace &ws){});
+
+  return EXIT_SUCCESS;
+}
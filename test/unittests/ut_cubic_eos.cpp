@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For sqrt, cbrt, cos, acos, and fabs
+#include <vector> // For std::vector
+
+// The library being tested
+#include <cubic-eos.h>
+
+/// Compute the smallest and largest real roots of Z^3 + c2*Z^2 + c1*Z + c0 in closed form
+
+int cubicRoots(const double c2, const double c1, const double c0, double &zl, double &zv){
+  // Depressed cubic, t^3 + p*t + q, with Z = t - c2/3
+  const double pi = 3.14159265358979323846;
+  const double p  = c1 - c2*c2/3.0;
+  const double q  = 2.0*c2*c2*c2/27.0 - c2*c1/3.0 + c0;
+  const double D  = q*q/4.0 + p*p*p/27.0;
+
+  if(D > 0.0){
+    // A single real root
+    zl = zv = cbrt(-q/2.0 + sqrt(D)) + cbrt(-q/2.0 - sqrt(D)) - c2/3.0;
+    return 1;
+  } // End if D > 0.0
+
+  // Three real roots (trigonometric method)
+  const double m  = 2.0*sqrt(-p/3.0);
+  const double th = acos(3.0*q/(p*m))/3.0;
+  zv = m*cos(th) - c2/3.0;
+  zl = m*cos(th + 2.0*pi/3.0) - c2/3.0;
+  return 3;
+}
+
+/// Test the batched cubic equation of state solver
+
+int main(int argc, char **argv){
+  // Parameters of the Peng-Robinson equation of state (both one and three real roots)
+  const size_t n = 1000;
+  std::vector<double> A(n), B(n);
+  for(size_t j = 0; j != n; ++j){
+    A[j] = 0.05 + 0.5*j/n;
+    B[j] = 0.01 + 0.05*((j*37)%n)/n;
+  } // End for j
+
+  // Coefficients
+  std::vector<double> c2(n), c1(n), c0(n);
+  CubicEos::pengRobinson(n, A.data(), B.data(), c2.data(), c1.data(), c0.data());
+
+  // Roots and branches
+  std::vector<double> Zl(n), Zv(n);
+  std::vector<unsigned char> branch(n);
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    const CubicEos eos(HiSolve(1.0e-13, 50, 3, true, strat));
+
+    // Cold start
+    if(eos.solve(n, c2.data(), c1.data(), c0.data(), Zl.data(), Zv.data(), branch.data()) != n){ return EXIT_FAILURE; }
+
+    size_t nTwoPhase = 0;
+    for(size_t j = 0; j != n; ++j){
+      double zl, zv;
+      const int nroots = cubicRoots(c2[j], c1[j], c0[j], zl, zv);
+
+      if(fabs(Zl[j] - zl) > 1.0e-8 || fabs(Zv[j] - zv) > 1.0e-8){ return EXIT_FAILURE; }
+      if((nroots == 3) != (branch[j] == CubicEosTwoPhase)){ return EXIT_FAILURE; }
+      if(nroots == 1 && branch[j] != (zv < -c2[j]/3.0 ? CubicEosLiquid : CubicEosVapor)){ return EXIT_FAILURE; }
+      nTwoPhase += nroots == 3;
+    } // End for j
+
+    // Make sure that both cases are covered
+    if(nTwoPhase == 0 || nTwoPhase == n){ return EXIT_FAILURE; }
+
+    // Warm start from the roots of slightly different cubics (e.g. the previous time step)
+    std::vector<double> Zl0(Zl), Zv0(Zv);
+    for(size_t j = 0; j != n; ++j){ A[j] *= 1.001; }
+    CubicEos::pengRobinson(n, A.data(), B.data(), c2.data(), c1.data(), c0.data());
+
+    if(eos.solve(n, c2.data(), c1.data(), c0.data(), Zl.data(), Zv.data(), branch.data(), true) != n){ return EXIT_FAILURE; }
+    for(size_t j = 0; j != n; ++j){
+      double zl, zv;
+      cubicRoots(c2[j], c1[j], c0[j], zl, zv);
+      if(fabs(Zl[j] - zl) > 1.0e-8 || fabs(Zv[j] - zv) > 1.0e-8){ return EXIT_FAILURE; }
+    } // End for j
+  } // End for strat
+
+  // Soave-Redlich-Kwong (ideal gas limit, A = B = 0, gives Z = 1)
+  const double zero = 0.0;
+  double c2s, c1s, c0s, zl, zv;
+  unsigned char b;
+  CubicEos::soaveRedlichKwong(1, &zero, &zero, &c2s, &c1s, &c0s);
+  const CubicEos eos(HiSolve(1.0e-13, 50, 3, true, 3));
+  eos.solve(1, &c2s, &c1s, &c0s, &zl, &zv, &b);
+  if(fabs(zv - 1.0) > 1.0e-12){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
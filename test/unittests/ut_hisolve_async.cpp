@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs
+#include <chrono> // For steady_clock
+
+// The library being tested
+#include <hi-solve-async.h>
+#include <latency-fun.h>
+#include <poly-fun.h>
+
+/// Polynomial which does not use the staged protocol and which throws when evaluated beyond a limit
+
+class Limited : public PolyFun {
+  public:
+    double limit; // Largest value at which the polynomial can be evaluated
+
+  Limited(const std::vector<double> &a, const double limit) : PolyFun(a), limit(limit) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    if(x > limit){ throw "Out of range."; }
+    PolyFun::eval(x, N, df);
+  }
+
+  bool hasStagedEval() const override { return false; }
+};
+
+/// Test the asynchronous solves of HiSolve
+
+int main(int argc, char **argv){
+  // (x - 1)*(x - 2)*(x - 3)*(x - 5)*(x + 1)
+  const std::vector<double> a = {30.0, -31.0, -20.0, 30.0, -10.0, 1.0};
+  const Limited p(a, 1.0e3);
+
+  // Initial guesses
+  const size_t n = 400;
+  std::vector<double> x0(n);
+  for(size_t i = 0; i != n; ++i){ x0[i] = -1.5 + 0.017*i; }
+
+  // Invalid arguments
+  try{ HiSolveScheduler(HiSolve(3), 0); return EXIT_FAILURE; } catch(const char*){}
+  HiSolve adaptive(3);
+  adaptive.setAdaptiveOrder(true);
+  try{ HiSolveResumable r(adaptive); return EXIT_FAILURE; } catch(const char*){}
+
+  // The asynchronous solves agree with the synchronous solves
+  const LatencyFun fast(p, std::chrono::microseconds(0));
+  for(size_t strat = 1; strat != 4; ++strat){
+    for(int UseMaxOrder = 0; UseMaxOrder != 2; ++UseMaxOrder){
+      const HiSolve solver(1.0e-10, 30, 4, UseMaxOrder, strat);
+      const std::vector<SolveResult> results = HiSolveScheduler(solver, 7).solve(fast, x0);
+      HiSolveWorkspace ws;
+      for(size_t i = 0; i != n; ++i){
+        const SolveResult r = solver.solve(p, x0[i], ws);
+        if(results[i].status != r.status || results[i].iterations != r.iterations || results[i].evaluations != r.evaluations){ return EXIT_FAILURE; }
+        if(results[i].order != r.order || results[i].df.size() != 0){ return EXIT_FAILURE; }
+        if(r.converged() && (fabs(results[i].x - r.x) > 1.0e-12 || fabs(results[i].f) >= 1.0e-10)){ return EXIT_FAILURE; }
+      } // End for i
+    } // End for UseMaxOrder
+  } // End for strat
+
+  // Many evaluations are outstanding at once, so the wall time is far below the sum of the latencies
+  const HiSolve solver(1.0e-10, 30, 3, true, 3);
+  const LatencyFun slow(p, std::chrono::milliseconds(2));
+  std::vector<SolveResult> results(n);
+  const auto start = std::chrono::steady_clock::now();
+  const size_t converged = HiSolveScheduler(solver, 200).solve(slow, n, x0.data(), results.data());
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if(converged != n || slow.getPeakOutstanding() < 100 || slow.getPeakOutstanding() > 200){ return EXIT_FAILURE; }
+  if(seconds > 0.25*slow.getEvaluations()*2.0e-3){ return EXIT_FAILURE; }
+
+  // Exceptions thrown by the evaluations are rethrown
+  const Limited q(a, 4.0);
+  const LatencyFun failing(q, std::chrono::microseconds(100));
+  try{ HiSolveScheduler(solver, 16).solve(failing, x0); return EXIT_FAILURE; } catch(const char*){}
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs, sin, and cos
+
+// The library being tested
+#include <hi-solve-continuation.h>
+
+/// Kepler's equation E - e*sin(E) - M = 0 with the mean anomaly M as the parameter
+
+class Kepler : public ParamFun {
+  public:
+    double e; // Eccentricity
+
+  Kepler(const double e) : e(e) {}
+
+  void eval(const double x, const double p, const size_t N, DfSpan df) const override {
+    const double s = sin(x), c = cos(x);
+    df[0] = x - e*s - p;
+    if(N > 0){ df[1] = 1.0 - e*c; }
+    for(size_t k = 2; k <= N; ++k){
+      // The derivatives of -e*sin(x) cycle with period 4
+      const double d[4] = {-e*s, -e*c, e*s, e*c};
+      df[k] = d[k%4];
+    } // End for k
+  }
+
+  double evalParam(const double x, const double p) const override { return -1.0; }
+};
+
+/// x^2 - p, whose positive root sqrt(p) turns back at p = 0
+
+class Fold : public ParamFun {
+  public:
+  void eval(const double x, const double p, const size_t N, DfSpan df) const override {
+    df[0] = x*x - p;
+    if(N > 0){ df[1] = 2.0*x; }
+    if(N > 1){ df[2] = 2.0; }
+    for(size_t k = 3; k <= N; ++k){ df[k] = 0.0; }
+  }
+
+  double evalParam(const double x, const double p) const override { return -1.0; }
+};
+
+/// x - g(p), where the root jumps from p to p + 10 at p = 1
+
+class Jump : public ParamFun {
+  public:
+  void eval(const double x, const double p, const size_t N, DfSpan df) const override {
+    df[0] = x - p - (p > 1.0 ? 10.0 : 0.0);
+    if(N > 0){ df[1] = 1.0; }
+    for(size_t k = 2; k <= N; ++k){ df[k] = 0.0; }
+  }
+
+  double evalParam(const double x, const double p) const override { return -1.0; }
+};
+
+/// Test the parameter continuation of HiSolve
+
+int main(int argc, char **argv){
+  const HiSolve solver(1.0e-12, 50, 3, true, 3);
+
+  // Invalid arguments
+  try{ HiSolveContinuation(solver, 0); return EXIT_FAILURE; } catch(const char*){}
+  try{ HiSolveContinuation(solver, 4, 0.0); return EXIT_FAILURE; } catch(const char*){}
+
+  const HiSolveContinuation continuation(solver);
+
+  // An empty sequence of parameter values
+  if(!continuation.track(Fold(), 1.0, {}).completed()){ return EXIT_FAILURE; }
+
+  // Kepler's equation along a sweep of the mean anomaly agrees with the cold solves, which need more evaluations
+  for(const double e : {0.1, 0.5, 0.9}){
+    const Kepler f(e);
+    std::vector<double> p;
+    for(size_t j = 0; j != 200; ++j){ p.push_back(0.03*j); }
+    const ContinuationResult r = continuation.track(f, 0.0, p);
+    if(!r.completed() || r.x.size() != p.size() || r.p != p.back() || r.xLast != r.x.back()){ return EXIT_FAILURE; }
+
+    HiSolveWorkspace ws;
+    size_t cold = 0;
+    for(size_t j = 0; j != p.size(); ++j){
+      std::vector<double> df(1);
+      f.eval(r.x[j], p[j], 0, df);
+      if(fabs(df[0]) >= 1.0e-12){ return EXIT_FAILURE; }
+
+      const SolveResult s = solver.solve(FixedParamFun(f, p[j]), 0.0, ws);
+      if(!s.converged() || fabs(s.x - r.x[j]) > 1.0e-10){ return EXIT_FAILURE; }
+      cold += s.evaluations;
+    } // End for j
+    if(r.evaluations >= cold || r.steps < p.size()-1){ return EXIT_FAILURE; }
+
+    // The tangent is dE/dM = 1/(1 - e*cos(E))
+    if(fabs(r.dxdp - 1.0/(1.0 - e*cos(r.xLast))) > 1.0e-12){ return EXIT_FAILURE; }
+  } // End for e
+
+  // Large gaps between the parameter values are bridged by several steps, in both directions
+  {
+    const ContinuationResult r = continuation.track(Kepler(0.9), 0.0, {0.0, 6.0, 0.5});
+    if(!r.completed() || r.x.size() != 3 || r.steps <= 2 || fabs(r.x[2] - 0.9*sin(r.x[2]) - 0.5) >= 1.0e-12){ return EXIT_FAILURE; }
+  }
+
+  // The root sqrt(p) is tracked until just before the turning point at p = 0
+  {
+    const ContinuationResult r = continuation.track(Fold(), 2.1, {4.0, 1.0, 0.25, -1.0});
+    if(r.status != ContinuationTurningPoint || r.x.size() != 3 || fabs(r.x[2] - 0.5) > 1.0e-12){ return EXIT_FAILURE; }
+    if(r.p <= 0.0 || r.p > 1.0e-3 || fabs(r.xLast*r.xLast - r.p) >= 1.0e-12 || r.xLast <= 0.0 || r.rejected == 0){ return EXIT_FAILURE; }
+  }
+
+  // The jump of the root at p = 1 is detected as the loss of the branch
+  {
+    const ContinuationResult r = continuation.track(Jump(), 0.0, {0.0, 0.5, 2.0});
+    if(r.status != ContinuationBranchLost || r.x.size() != 2 || r.p > 1.0 || r.p < 1.0 - 1.0e-6){ return EXIT_FAILURE; }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For sin, cos, and fabs
+
+// The library being tested
+#include <hi-solve.h>
+#include <hi-solve-engine.h>
+
+/// Evaluate sine and its derivatives (only as many as fit in df)
+
+template<class DfT>
+void sine(const double x, const size_t N, DfT &&df){
+  for(size_t k = 0; k != N+1 && k != df.size(); ++k){
+    df[k] = k%2 == 0 ? sin(x) : cos(x);
+
+    // Negate if necessary
+    if(k%4 > 1){ df[k] *= -1.0; }
+  } // End for k
+}
+
+/// Function object wrapping sine
+
+class Sine : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override { sine(x, N, df); }
+};
+
+/// Solve using a specialization of HiSolveEngine and compare with HiSolve
+
+template<size_t Nmax, size_t Strategy, bool UseMaxOrder>
+bool test(const double x0, const double tol, const size_t maxit){
+  typedef HiSolveEngine<Nmax, Strategy, UseMaxOrder> Engine;
+
+  // Solve with the function value and derivatives stored in a std::array
+  const double x = Engine::solve([](const double x, const size_t N, typename Engine::Df &df){ sine(x, N, df); }, x0, tol, maxit);
+  if(fabs(x) > tol){ return false; }
+
+  // The runtime dispatch in HiSolve must give the same result as the specialization
+  const Sine f;
+  HiSolve solver(tol, maxit, Nmax, UseMaxOrder, Strategy);
+  std::vector<double> df(Nmax+2);
+  const double xe = Engine::solve([&f](const double x, const size_t N, std::vector<double> &df){ f.eval(x, N, df); }, df, x0, tol, maxit).x;
+
+  if(xe != solver.solve(f, x0)){ return false; }
+
+  // The specialized update has the same arithmetic as the update strategy chosen at run time (i.e. bit-identical updates)
+  std::vector<double> dfr(Nmax+2);
+  for(size_t i = 0; i != Nmax+2; ++i){ dfr[i] = (i%2 ? -1.0 : 1.0)*(0.37 + 0.61*i)/(1.0 + i*i); }
+  for(size_t N = 1; N <= Nmax; ++N){
+    if(Engine::update(dfr, N) != hiSolveUpdate(Strategy, dfr, N)){ return false; }
+  } // End for N
+
+  return true;
+}
+
+/// Test the compile-time specialized engine
+
+int main(int argc, char **argv){
+  // Tolerance, maximum number of iterations, and initial guess (the answer is l*pi for any integer l)
+  const double tol   = 1.0e-12;
+  const size_t maxit = 20;
+  const double x0    = 0.17;
+
+  if(!test<5, 1, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<5, 2, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<5, 3, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<5, 4, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<1, 4, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<1, 4, false>(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<3, 2, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+  if(!test<8, 3, true >(x0, tol, maxit)){ return EXIT_FAILURE; }
+
+  // Check the generic (not specialized) path
+  const Sine f;
+  HiSolve solver(tol, maxit, HiSolve::NmaxSpecialized + 2, true, 3);
+  if(fabs(solver.solve(f, x0)) > tol){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
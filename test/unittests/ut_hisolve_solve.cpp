@@ -32,7 +32,7 @@ SOFTWARE.
 
 class Sine : public Fun {
   public:
-  void eval(const double x, const size_t N, std::vector<double> &df) const override {
+  void eval(const double x, const size_t N, DfSpan df) const override {
     // Evaluate sine and its derivatives
     for(int k = 0; k != N; ++k){
       switch(k%2){
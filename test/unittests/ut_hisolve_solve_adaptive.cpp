@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For exp and fabs
+
+// The library being tested
+#include <hi-solve.h>
+
+/// Function object for exp(x) - 2 which accumulates the cost of the evaluations
+
+class ExpFun : public Fun {
+  public:
+    std::vector<double> costs;      // Cost of evaluating up to each order
+    mutable double      cost = 0.0; // Accumulated cost
+
+  void eval(const double x, const size_t N, DfSpan df) const {
+    cost += costs[N];
+
+    const double e = exp(x);
+    for(size_t k = 0; k != N+1; ++k){ df[k] = e; }
+    df[0] -= 2.0;
+  }
+};
+
+/// Test the adaptive-order variant of the solve function in HiSolve
+
+int main(int argc, char **argv){
+  // Tolerance, maximum number of iterations, and initial guess (the answer is log(2))
+  const double tol   = 1.0e-13;
+  const size_t maxit = 30;
+  const double x0    = 1.5;
+  const size_t Nmax  = 6;
+
+  // The cost of the derivatives grows rapidly with the order
+  ExpFun f;
+  for(size_t k = 0; k != Nmax+2; ++k){ f.costs.push_back(k == 0 ? 1.0 : f.costs.back() + pow(4.0, k)); }
+
+  // The default is not to use the adaptive-order variant
+  HiSolve solver(tol, maxit, Nmax, true, 3);
+  if(solver.getAdaptiveOrder() || !solver.getOrderCosts().empty()){ return EXIT_FAILURE; }
+
+  // The costs must be positive
+  bool Thrown = false;
+  try{ solver.setOrderCosts({1.0, 0.0}); } catch(const char*){ Thrown = true; }
+  if(!Thrown || !solver.getOrderCosts().empty()){ return EXIT_FAILURE; }
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    solver.setUpdateStrategy(strat);
+
+    // Maximum-order variant
+    solver.setAdaptiveOrder(false);
+    f.cost = 0.0;
+    solver.solve(f, x0);
+    const double CostMaxOrder = f.cost;
+
+    // Adaptive-order variant using the cost model
+    solver.setAdaptiveOrder(true);
+    solver.setOrderCosts(f.costs);
+    if(!solver.getAdaptiveOrder() || solver.getOrderCosts() != f.costs){ return EXIT_FAILURE; }
+
+    HiSolveWorkspace ws;
+    f.cost = 0.0;
+    const SolveResult ra = solver.solve(f, x0, ws);
+    const double CostAdaptive = f.cost;
+
+    if(!ra.converged() || fabs(ra.x - log(2.0)) > 1.0e-12 || fabs(ra.f) >= tol){ return EXIT_FAILURE; }
+    if(ra.df[0] != ra.f || ra.order > Nmax){ return EXIT_FAILURE; }
+
+    // The adaptive-order variant must be cheaper since high orders are expensive
+    if(CostAdaptive >= CostMaxOrder){ return EXIT_FAILURE; }
+
+    // The adaptive-order variant also works with a generic callable and the default cost model
+    solver.setOrderCosts({});
+    const auto g = [&f](const double x, const size_t N, double *df){ f.eval(x, N, DfSpan(df, N+1)); };
+    if(fabs(solver.solve(g, x0) - log(2.0)) > 1.0e-12){ return EXIT_FAILURE; }
+    solver.setOrderCosts(f.costs);
+  } // End for strat
+
+  // The measured cost model has a positive and non-decreasing cost for each order
+  const std::vector<double> costs = HiSolve::measureOrderCosts(f, x0, Nmax, 10);
+  if(costs.size() != Nmax+1 || !(costs[0] > 0.0)){ return EXIT_FAILURE; }
+  for(size_t k = 1; k != Nmax+1; ++k){
+    if(costs[k] < costs[k-1]){ return EXIT_FAILURE; }
+  } // End for k
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For sin, cos, and fabs
+
+// The library being tested
+#include <hi-solve.h>
+
+/// Basic class for testing the solveBatch function in HiSolve (uses the default, scalar evalBatch)
+
+class Sine : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    // Evaluate sine and its derivatives
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = k%2 == 0 ? sin(x) : cos(x);
+
+      // Negate if necessary
+      if(k%4 > 1){ df[k] *= -1.0; }
+    } // End for k
+  }
+};
+
+/// Class for testing the solveBatch function in HiSolve with a batched function evaluation
+
+class SineBatch : public Sine {
+  public:
+  void evalBatch(const double *x, const size_t n, const size_t N, double *dfSoA) const override {
+    for(size_t i = 0; i != n; ++i){
+      // Sine and cosine are only computed once for all derivatives
+      const double s = sin(x[i]);
+      const double c = cos(x[i]);
+
+      for(size_t k = 0; k != N+1; ++k){
+        const double dfk = k%2 == 0 ? s : c;
+        dfSoA[k*n + i] = k%4 > 1 ? -dfk : dfk;
+      } // End for k
+    } // End for i
+  }
+};
+
+/// Test the solveBatch function in HiSolve
+
+int main(int argc, char **argv){
+  // Create function objects
+  const Sine      f;
+  const SineBatch g;
+
+  // Highest order derivative to be used, tolerance, and maximum number of iterations
+  const size_t Nmax  = 5;
+  const double tol   = 1.0e-12;
+  const size_t maxit = 20;
+
+  // Initial guesses close to 0 and pi (more than one block of lanes)
+  const double pi = 3.14159265358979323846;
+  const size_t n  = 1500;
+  std::vector<double> x0(n), x(n), xref(n);
+  for(size_t i = 0; i != n; ++i){
+    xref[i] = i%2 == 0 ? 0.0 : pi;
+    x0  [i] = xref[i] + 0.4*((double) i/n - 0.5);
+  } // End for i
+
+  // Per-lane convergence flags
+  bool *Converged = new bool[n];
+
+  for(size_t strat = 1; strat != 4; ++strat){
+    for(int UseMaxOrder = 0; UseMaxOrder != 2; ++UseMaxOrder){
+      // Create solver
+      const HiSolve solver(tol, maxit, Nmax, UseMaxOrder, strat);
+
+      // Solve using both the default and the batched function evaluation
+      for(int batched = 0; batched != 2; ++batched){
+        const size_t nConverged = batched ? solver.solveBatch(g, n, x0.data(), x.data(), Converged)
+                                          : solver.solveBatch(f, n, x0.data(), x.data(), Converged);
+
+        // Check that all equations converged to the correct root
+        if(nConverged != n){ delete [] Converged; return EXIT_FAILURE; }
+        for(size_t i = 0; i != n; ++i){
+          if(!Converged[i] || fabs(x[i] - xref[i]) > 1.0e-10){ delete [] Converged; return EXIT_FAILURE; }
+        } // End for i
+      } // End for batched
+    } // End for UseMaxOrder
+  } // End for strat
+
+  // Check that lanes which do not converge are flagged (only a single iteration is allowed)
+  const HiSolve solver(tol, 1, Nmax, true, 3);
+  const size_t nConverged = solver.solveBatch(g, n, x0.data(), x.data(), Converged);
+  delete [] Converged;
+
+  if(nConverged == n){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For sin, cos, and fabs
+
+// The library being tested
+#include <hi-solve.h>
+
+/// Functor for testing the solve function in HiSolve with a generic callable
+
+class SineFunctor {
+  public:
+  void operator()(const double x, const size_t N, double *df) const {
+    // Sine and cosine are only computed once for all derivatives
+    const double s = sin(x);
+    const double c = cos(x);
+
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = k%2 == 0 ? s : c;
+
+      // Negate if necessary
+      if(k%4 > 1){ df[k] *= -1.0; }
+    } // End for k
+  }
+};
+
+/// Test the solve function in HiSolve with generic callables
+
+int main(int argc, char **argv){
+  // Tolerance, maximum number of iterations, and initial guess (the answer is l*pi for any integer l)
+  const double tol   = 1.0e-12;
+  const size_t maxit = 20;
+  const double x0    = 0.17;
+
+  // Lambda evaluating a cubic polynomial, (x - 1)*(x - 2)*(x - 3), and its derivatives
+  const auto cubic = [](const double x, const size_t N, double *df){
+    df[0] = ((x - 6.0)*x + 11.0)*x - 6.0;
+    if(N > 0){ df[1] = (3.0*x - 12.0)*x + 11.0; }
+    if(N > 1){ df[2] = 6.0*x - 12.0; }
+    if(N > 2){ df[3] = 6.0; }
+    for(size_t k = 4; k < N+1; ++k){ df[k] = 0.0; }
+  };
+
+  // Count the number of evaluations using a lambda with captures
+  size_t neval = 0;
+  const SineFunctor sine;
+  const auto counted = [&neval, &sine](const double x, const size_t N, double *df){ ++neval; sine(x, N, df); };
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    // Both a specialized and a generic (not specialized) value of Nmax
+    for(size_t Nmax = 3; Nmax < 2*HiSolve::NmaxSpecialized; Nmax += HiSolve::NmaxSpecialized){
+      HiSolve solver(tol, maxit, Nmax, true, strat);
+
+      // Functor
+      if(fabs(solver.solve(sine, x0)) > tol){ return EXIT_FAILURE; }
+
+      // Lambda (the root closest to the initial guess is 3)
+      if(fabs(solver.solve(cubic, 3.2) - 3.0) > tol){ return EXIT_FAILURE; }
+
+      // Lambda with captures
+      neval = 0;
+      if(fabs(solver.solve(counted, x0)) > tol || neval == 0){ return EXIT_FAILURE; }
+    } // End for Nmax
+  } // End for strat
+
+  return EXIT_SUCCESS;
+}
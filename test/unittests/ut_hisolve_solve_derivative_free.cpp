@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For sin, exp, log, and fabs
+
+// The library being tested
+#include <hi-solve.h>
+#include <poly-fun.h>
+
+/// Function object for sin(x) - x/2 which only evaluates the function value (and records the highest order requested)
+
+class SineLinear : public Fun {
+  public:
+    mutable size_t Nmax = 0; // Highest order requested
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    Nmax  = std::max(Nmax, N);
+    df[0] = sin(x) - 0.5*x;
+  }
+};
+
+/// Function object for exp(x) - 2 which only evaluates the function value
+
+class Exp : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override { df[0] = exp(x) - 2.0; }
+};
+
+/// Test the derivative-free variant of HiSolve
+
+int main(int argc, char **argv){
+  // Tolerance and maximum number of iterations
+  const double tol   = 1.0e-12;
+  const size_t maxit = 50;
+
+  // (x - 1)*(x - 2)*(x - 3)*(x - 5)*(x + 1)
+  const PolyFun p({30.0, -31.0, -20.0, 30.0, -10.0, 1.0});
+  const SineLinear  s;
+  const Exp         e;
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    // Total number of function evaluations for the secant method (Nmax = 1) and for Nmax = 4
+    size_t evaluations[2] = {0, 0};
+
+    for(const size_t Nmax : {1, 4, 12}){
+      HiSolve solver(tol, maxit, Nmax, true, strat);
+      HiSolveWorkspace ws;
+      size_t total = 0;
+
+      // The same roots are found as with the derivatives
+      for(const double x0 : {4.7, 5.5, 0.6}){
+        const SolveResult r = solver.solveDerivativeFree(p, x0, ws);
+        if(!r.converged() || fabs(r.x - solver.solve(p, x0)) > 1.0e-10 || r.df.size() != 1 || r.df[0] != r.f){ return EXIT_FAILURE; }
+        total += r.evaluations;
+      } // End for x0
+
+      const SolveResult rs = solver.solveDerivativeFree(s, 2.0, ws);
+      if(!rs.converged() || fabs(sin(rs.x) - 0.5*rs.x) > tol || s.Nmax != 0){ return EXIT_FAILURE; }
+      total += rs.evaluations;
+
+      const SolveResult re = solver.solveDerivativeFree(e, 3.0, ws);
+      if(!re.converged() || fabs(re.x - log(2.0)) > 1.0e-12 || re.evaluations != re.iterations + 2){ return EXIT_FAILURE; }
+
+      // The Pade approximant is sensitive to the poorly estimated high-order derivatives far from the root of exp(x) - 2, so it is not counted for strategy 4
+      if(strat != 4){ total += re.evaluations; }
+
+      if(Nmax == 1){ evaluations[0] = total; }
+      if(Nmax == 4){ evaluations[1] = total; }
+    } // End for Nmax
+
+    // Using more points of the history reduces the number of function evaluations
+    if(evaluations[1] >= evaluations[0]){ return EXIT_FAILURE; }
+  } // End for strat
+
+  // The estimated derivative is zero
+  const PolyFun q({1.0});
+  const HiSolve solver(tol, maxit, 3, true, 1);
+  HiSolveWorkspace ws;
+  const SolveResult rq = solver.solveDerivativeFree(q, 0.5, ws);
+  if(rq.status != SolveZeroDerivative || rq.iterations != 0 || rq.evaluations != 2){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs, sqrt, and ldexp
+#include <limits> // For std::numeric_limits
+#include <type_traits> // For std::is_same
+
+// The library being tested
+#include <hi-solve.h>
+#include <poly-fun.h>
+#include <double-double.h>
+
+/// x^2 - 2 and its derivatives in any scalar type
+
+struct Sqrt2 {
+  template<class T>
+  void operator()(const T x, const size_t N, T *df) const {
+    df[0] = x*x - T(2.0);
+    if(N > 0){ df[1] = T(2.0)*x; }
+    if(N > 1){ df[2] = T(2.0); }
+    for(size_t k = 3; k <= N; ++k){ df[k] = T(0.0); }
+  }
+};
+
+/// x^2 - 2 which (artificially) overflows in float
+
+struct Overflow {
+  template<class T>
+  void operator()(const T x, const size_t N, T *df) const {
+    Sqrt2()(x, N, df);
+    if(std::is_same<T, float>::value){ df[0] = std::numeric_limits<T>::infinity(); }
+  }
+};
+
+/// x^2 - 2 which (artificially) has no real root in float, i.e. the iterations in float do not converge
+
+struct NoRootFloat {
+  template<class T>
+  void operator()(const T x, const size_t N, T *df) const {
+    Sqrt2()(x, N, df);
+    if(std::is_same<T, float>::value){ df[0] = x*x + T(1.0); }
+  }
+};
+
+/// Test the mixed-precision variant of HiSolve
+
+int main(int argc, char **argv){
+  // Double-double arithmetic: (1 + 2^-60)^2 = 1 + 2^-59 + 2^-120
+  const double        eps = std::ldexp(1.0, -60);
+  const DoubleDouble  a   = DoubleDouble(1.0) + eps;
+  const DoubleDouble  b   = a*a;
+  if(b.hi != 1.0 || b.lo != 2.0*eps){ return EXIT_FAILURE; }
+  if(fabs(static_cast<double>((b/a - a).lo)) > 1.0e-31 || (b - a).hi != eps){ return EXIT_FAILURE; }
+  if(!(a > DoubleDouble(1.0)) || !(-a < 0.0) || fabs(-a) != a){ return EXIT_FAILURE; }
+
+  // Tolerance, maximum number of iterations, and initial guess
+  const double tol   = 1.0e-12;
+  const size_t maxit = 30;
+  const double x0    = 4.7;
+
+  // (x - 1)*(x - 2)*(x - 3)*(x - 5)*(x + 1)
+  const PolyFun p({30.0, -31.0, -20.0, 30.0, -10.0, 1.0});
+  const auto pg  = [&p](const auto x, const size_t N, auto *df){ p.evalGeneric(x, N, df); };
+  const auto pgb = [&p](const auto *x, const size_t n, const size_t N, auto *df){ p.evalBatchGeneric(x, n, N, df); };
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    // Both specialized and generic (not specialized) values of Nmax
+    for(const size_t Nmax : {3, 12}){
+      HiSolve solver(tol, maxit, Nmax, true, strat);
+      HiSolveWorkspace ws;
+
+      // The same root is found as in double precision
+      const SolveResult r = solver.solveMixed(pg, x0, ws);
+      if(!r.converged() || fabs(r.x - solver.solve(p, x0)) > 1.0e-12 || fabs(r.x - 5.0) > 1.0e-12){ return EXIT_FAILURE; }
+      if(r.xLow != 0.0 || r.df.size() == 0 || r.df[0] != r.f){ return EXIT_FAILURE; }
+
+      // Polish the square root of 2 in double-double precision
+      HiSolve polisher(1.0e-30, maxit, Nmax, true, strat);
+      polisher.setMixedPolish(true);
+      const SolveResult rp = polisher.solveMixed(Sqrt2(), 1.0, ws);
+      const DoubleDouble xp(rp.x, rp.xLow);
+      if(!rp.converged() || rp.x != std::sqrt(2.0) || rp.xLow == 0.0){ return EXIT_FAILURE; }
+      if(fabs(xp*xp - 2.0) > 1.0e-30 || rp.df.size() != 0){ return EXIT_FAILURE; }
+
+      // The initial guess is used in double if the iterations in float fail (after a single evaluation in float)
+      const SolveResult ro = solver.solveMixed(Overflow(), 1.0, ws);
+      if(!ro.converged() || fabs(ro.x - std::sqrt(2.0)) > 1.0e-12 || ro.evaluations != solver.solve(Sqrt2(), 1.0, ws).evaluations + 1){ return EXIT_FAILURE; }
+
+      // The batched variant iterates in float lanes and finds the same roots as the batched solver in double
+      const size_t n = 37;
+      std::vector<double> x0b(n), xm(n), xd(n);
+      for(size_t i = 0; i != n; ++i){ x0b[i] = -1.5 + 0.2*i; }
+      bool Converged[n];
+      const size_t nm = solver.solveBatchMixed(pgb, n, x0b.data(), xm.data(), Converged);
+      const size_t nd = solver.solveBatch(p, n, x0b.data(), xd.data());
+      if(nm != n || nd != n){ return EXIT_FAILURE; }
+      for(size_t i = 0; i != n; ++i){
+        if(!Converged[i] || fabs(xm[i] - xd[i]) > 1.0e-10){ return EXIT_FAILURE; }
+      } // End for i
+
+      // The initial guess is also used in double if the iterations in float stop without converging (e.g. at a zero derivative)
+      const SolveResult rn = solver.solveMixed(NoRootFloat(), 1.0, ws);
+      if(!rn.converged() || fabs(rn.x - std::sqrt(2.0)) > 1.0e-12){ return EXIT_FAILURE; }
+    } // End for Nmax
+  } // End for strat
+
+  // Invalid switching tolerances
+  HiSolve solver(3);
+  try{ solver.setMixedSwitchTol(1.0); return EXIT_FAILURE; } catch(const char*){}
+  solver.setMixedSwitchTol(1.0e-2);
+  if(solver.getMixedSwitchTol() != 1.0e-2 || solver.getMixedPolish()){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
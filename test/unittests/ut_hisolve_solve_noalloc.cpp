@@ -0,0 +1,128 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS, EXIT_FAILURE, malloc, and free
+#include <cmath> // For sin, cos, and fabs
+#include <new> // For std::bad_alloc
+
+// The library being tested
+#include <hi-solve.h>
+
+/// Number of heap allocations made while counting is enabled
+
+static bool   CountAllocations = false;
+static size_t Allocations      = 0;
+
+/// Replacements of the global allocation functions which count the allocations
+
+void *operator new(std::size_t size){
+  if(CountAllocations){ ++Allocations; }
+  void *p = std::malloc(size > 0 ? size : 1);
+  if(!p){ throw std::bad_alloc(); }
+  return p;
+}
+
+void *operator new[](std::size_t size){ return operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+/// Function object evaluating sine and all requested derivatives
+
+class Sine : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = k%2 == 0 ? sin(x) : cos(x);
+
+      // Negate if necessary
+      if(k%4 > 1){ df[k] *= -1.0; }
+    } // End for k
+  }
+};
+
+/// Test that solve is reentrant and does not allocate memory on the heap
+
+int main(int argc, char **argv){
+  // Create function object
+  const Sine f;
+
+  // Tolerance, maximum number of iterations, and initial guess (the answer is l*pi for any integer l)
+  const double tol   = 1.0e-12;
+  const size_t maxit = 20;
+  const double x0    = 0.17;
+
+  // Both specialized and generic (not specialized) values of Nmax, up to the largest one whose function values and derivatives are stored inside the workspace
+  const size_t Nmax[] = { 1, 5, HiSolve::NmaxSpecialized + 4, 16, HiSolveWorkspace::InlineSize - 2 };
+
+  // Callable evaluating sine
+  const auto g = [&f](const double x, const size_t N, double *df){ f.eval(x, N, DfSpan(df, N+1)); };
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    for(const size_t nmax : Nmax){
+      const HiSolve solver(tol, maxit, nmax, true, strat);
+      HiSolveWorkspace ws(nmax);
+
+      // Solve with the caller-owned workspace, with a workspace on the stack, and with a callable
+      Allocations      = 0;
+      CountAllocations = true;
+      const double x1 = solver.solve(f, x0, ws).x;
+      const double x2 = solver.solve(f, x0);
+      const double x3 = solver.solve(g, x0);
+      CountAllocations = false;
+
+      if(Allocations != 0){ return EXIT_FAILURE; }
+      if(fabs(x1) > tol || x1 != x2 || fabs(x3) > tol){ return EXIT_FAILURE; }
+    } // End for nmax
+  } // End for strat
+
+  // Increasing Nmax after construction must not make the evaluations write past the end of the function values and derivatives
+  HiSolve solver(5);
+  solver.setTol(tol);
+  solver.setNmax(HiSolveWorkspace::InlineSize + 10);
+  HiSolveWorkspace ws;
+  if(fabs(solver.solve(f, x0, ws).x) > tol){ return EXIT_FAILURE; }
+
+  // Once the workspace is large enough, no more memory is allocated (including the scratch values of the Pade approximant for Nmax > 31)
+  for(size_t strat = 1; strat != 5; ++strat){
+    solver.setUpdateStrategy(strat);
+    for(int AdaptiveOrder = 0; AdaptiveOrder != 2; ++AdaptiveOrder){
+      solver.setAdaptiveOrder(AdaptiveOrder);
+
+      Allocations      = 0;
+      CountAllocations = true;
+      const double x1 = solver.solve(f, x0, ws).x;
+      const double x3 = solver.solve(g, x0, ws).x;
+      const double x4 = solver.solveSafeguarded(f, x0, ws).x;
+      CountAllocations = false;
+
+      if(Allocations != 0){ return EXIT_FAILURE; }
+      if(fabs(x1) > tol || fabs(x3) > tol || fabs(x4) > tol){ return EXIT_FAILURE; }
+    } // End for AdaptiveOrder
+  } // End for strat
+
+  return EXIT_SUCCESS;
+}
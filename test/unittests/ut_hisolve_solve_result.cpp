@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For sin, cos, fabs, and NAN
+
+// The library being tested
+#include <hi-solve.h>
+
+/// Function object for testing the result of the solve function in HiSolve
+
+class Sine : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const {
+    // Sine and cosine are only computed once for all derivatives
+    const double s = sin(x);
+    const double c = cos(x);
+
+    for(size_t k = 0; k != N+1; ++k){
+      df[k] = k%2 == 0 ? s : c;
+
+      // Negate if necessary
+      if(k%4 > 1){ df[k] *= -1.0; }
+    } // End for k
+  }
+};
+
+/// Test the result of the solve function in HiSolve
+
+int main(int argc, char **argv){
+  // Tolerance, maximum number of iterations, and initial guess (the answer is l*pi for any integer l)
+  const double tol   = 1.0e-12;
+  const size_t maxit = 20;
+  const double x0    = 0.17;
+
+  const Sine f;
+
+  // The number of evaluations is counted using a callable
+  size_t neval = 0;
+  size_t order = 0;
+  const auto counted = [&](const double x, const size_t N, double *df){
+    ++neval;
+    order = std::max(order, N);
+    f.eval(x, N, DfSpan(df, N+1));
+  };
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    // Both specialized and generic (not specialized) values of Nmax
+    for(size_t Nmax = 1; Nmax < 2*HiSolve::NmaxSpecialized; Nmax += 5){
+      // Both variants of the algorithm
+      for(int UseMaxOrder = 0; UseMaxOrder != 2; ++UseMaxOrder){
+        HiSolve solver(tol, maxit, Nmax, UseMaxOrder, strat);
+        HiSolveWorkspace ws(Nmax);
+
+        // Converged
+        const SolveResult r = solver.solve(f, x0, ws);
+        if(!r.converged() || r.status != SolveConverged){ return EXIT_FAILURE; }
+        if(fabs(r.x) > tol || r.f != sin(r.x) || fabs(r.f) >= tol){ return EXIT_FAILURE; }
+        if(r.evaluations != r.iterations+1 || r.iterations == 0){ return EXIT_FAILURE; }
+        if(r.order > (UseMaxOrder ? Nmax : Nmax+1) || r.df.size() < 2 || r.df[0] != r.f || r.df[1] != cos(r.x)){ return EXIT_FAILURE; }
+
+        // The accounting of the callable version agrees with the number of evaluations
+        neval = 0;
+        order = 0;
+        const SolveResult rc = solver.solve(counted, x0, ws);
+        if(!rc.converged() || rc.evaluations != neval || rc.order != order || rc.x != r.x){ return EXIT_FAILURE; }
+
+        // Maximum number of iterations
+        solver.setMaxIt(1);
+        const SolveResult rm = solver.solve(f, 1.2, ws);
+        if(rm.status != SolveMaxIterations || rm.converged() || rm.iterations != 1 || rm.evaluations != 2){ return EXIT_FAILURE; }
+
+        // Zero derivative (the derivative of x^2 - 1 is zero at 0)
+        const auto parabola = [](const double x, const size_t N, double *df){
+          df[0] = x*x - 1.0;
+          if(N > 0){ df[1] = 2.0*x; }
+          if(N > 1){ df[2] = 2.0; }
+          for(size_t k = 3; k < N+1; ++k){ df[k] = 0.0; }
+        };
+        const SolveResult rz = solver.solve(parabola, 0.0, ws);
+        if(rz.status != SolveZeroDerivative || rz.iterations != 0 || rz.evaluations != 1 || rz.x != 0.0 || rz.f != -1.0){ return EXIT_FAILURE; }
+
+        // Not finite
+        const auto nan = [](const double x, const size_t N, double *df){ for(size_t k = 0; k != N+1; ++k){ df[k] = NAN; } };
+        const SolveResult rn = solver.solve(nan, x0, ws);
+        if(rn.status != SolveNonFinite || rn.iterations != 0 || rn.evaluations != 1){ return EXIT_FAILURE; }
+      } // End for UseMaxOrder
+    } // End for Nmax
+  } // End for strat
+
+  // The variable-order variant evaluates the first-order derivative in the first iteration and increases the order by one in each iteration
+  HiSolve solver(tol, maxit, 3, false, 1);
+  HiSolveWorkspace ws;
+  neval = 0;
+  order = 0;
+  const SolveResult r = solver.solve(counted, 1.2, ws);
+  if(!r.converged() || r.order != std::min(r.iterations+1, size_t(4))){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For atan, log, and fabs
+
+// The library being tested
+#include <hi-solve.h>
+
+/// Function object for atan(x) (Newton's method diverges for initial guesses far from the root at 0)
+
+class Atan : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const {
+    const double r = 1.0/(1.0 + x*x);
+    df[0] = atan(x);
+    if(N > 0){ df[1] = r; }
+    if(N > 1){ df[2] = -2.0*x*r*r; }
+    if(N > 2){ df[3] = (6.0*x*x - 2.0)*r*r*r; }
+  }
+};
+
+/// Function object for log(x) - 1 (which is not finite for negative x)
+
+class Log : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const {
+    df[0] = log(x) - 1.0;
+
+    // The k'th order derivative is (-1)^(k-1) (k-1)!/x^k
+    double d = 1.0/x;
+    for(size_t k = 1; k < N+1; ++k){
+      df[k] = d;
+      d    *= -double(k)/x;
+    } // End for k
+  }
+};
+
+/// Function object for x^2 - 1 (the first-order derivative is zero at 0)
+
+class Parabola : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const {
+    df[0] = x*x - 1.0;
+    if(N > 0){ df[1] = 2.0*x; }
+    if(N > 1){ df[2] = 2.0; }
+    for(size_t k = 3; k < N+1; ++k){ df[k] = 0.0; }
+  }
+};
+
+/// Test the safeguarded variant of the solve function in HiSolve
+
+int main(int argc, char **argv){
+  // Tolerance and maximum number of iterations
+  const double tol   = 1.0e-12;
+  const size_t maxit = 100;
+
+  const Atan      f;
+  const Log       g;
+  const Parabola  h;
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    for(size_t Nmax = 1; Nmax != 3; ++Nmax){
+      for(int UseMaxOrder = 0; UseMaxOrder != 2; ++UseMaxOrder){
+        const HiSolve solver(tol, maxit, Nmax, UseMaxOrder, strat);
+        HiSolveWorkspace ws;
+
+        // Converges from a good initial guess
+        SolveResult r = solver.solveSafeguarded(f, 0.5, ws);
+        if(!r.converged() || fabs(r.x) > tol){ return EXIT_FAILURE; }
+
+        // Divergence is detected after a few evaluations (the plain solve continues until the iterates overflow, and Newton's method, i.e. strategy 1, always diverges)
+        r = solver.solveSafeguarded(f, 10.0, ws);
+        if(strat == 1 && r.converged()){ return EXIT_FAILURE; }
+        if(!r.converged() && (r.status != SolveDiverged || r.evaluations > 4 || solver.solve(f, 10.0, ws).evaluations <= r.evaluations)){ return EXIT_FAILURE; }
+
+        // Non-finite values and zero derivatives are detected immediately
+        r = solver.solveSafeguarded(g, 30.0, ws);
+        if(r.status != SolveNonFinite || r.evaluations > 3){ return EXIT_FAILURE; }
+        r = solver.solveSafeguarded(h, 0.0, ws);
+        if(r.status != SolveZeroDerivative || r.evaluations != 1){ return EXIT_FAILURE; }
+
+        // With a bracket, the iterations converge from the same initial guesses
+        r = solver.solveSafeguarded(f, 10.0, -1.0, 20.0, ws);
+        if(!r.converged() || fabs(r.x) > tol || r.evaluations > 30){ return EXIT_FAILURE; }
+        r = solver.solveSafeguarded(g, 30.0, 40.0, 0.5, ws);
+        if(!r.converged() || fabs(r.x - exp(1.0)) > 1.0e-10){ return EXIT_FAILURE; }
+        r = solver.solveSafeguarded(h, 0.0, -0.5, 3.0, ws);
+        if(!r.converged() || fabs(r.x - 1.0) > tol){ return EXIT_FAILURE; }
+        if(fabs(solver.solveSafeguarded(h, 0.0, -0.5, 3.0) - r.x) != 0.0){ return EXIT_FAILURE; }
+
+        // The function must change sign in the bracket
+        r = solver.solveSafeguarded(f, 2.0, 1.0, 3.0, ws);
+        if(r.status != SolveNoSignChange || r.x != 1.0 || r.f != atan(1.0) || r.evaluations != 2){ return EXIT_FAILURE; }
+
+        // The ends of the bracket may be solutions
+        r = solver.solveSafeguarded(h, 0.0, 1.0, 3.0, ws);
+        if(!r.converged() || r.x != 1.0){ return EXIT_FAILURE; }
+      } // End for UseMaxOrder
+    } // End for Nmax
+  } // End for strat
+
+  return EXIT_SUCCESS;
+}
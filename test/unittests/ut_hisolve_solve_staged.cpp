@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs, pow, and isfinite
+
+// The library being tested
+#include <hi-solve.h>
+#include <poly-fun.h>
+
+/// Polynomial which records the orders requested and optionally disables the staged protocol
+
+class Recorded : public PolyFun {
+  public:
+    bool                        Staged;   // Whether or not to use the staged protocol
+    mutable std::vector<size_t> orders;   // Highest order requested at each new scalar value
+    mutable size_t              more = 0; // Number of calls to evalMore
+
+  Recorded(const std::vector<double> &a, const bool Staged) : PolyFun(a), Staged(Staged) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    orders.push_back(N);
+    PolyFun::eval(x, N, df);
+  }
+
+  void evalMore(const double x, const size_t N0, const size_t N, DfSpan df) const override {
+    ++more;
+    PolyFun::evalMore(x, N0, N, df);
+  }
+
+  bool hasStagedEval() const override { return Staged; }
+};
+
+/// Test the staged protocol for evaluating the derivatives in HiSolve
+
+int main(int argc, char **argv){
+  // Tolerance, maximum number of iterations, and initial guess
+  const double tol   = 1.0e-12;
+  const size_t maxit = 30;
+  const double x0    = 4.7;
+
+  // (x - 1)*(x - 2)*(x - 3)*(x - 5)*(x + 1)
+  const std::vector<double> a = {30.0, -31.0, -20.0, 30.0, -10.0, 1.0};
+
+  // The staged evaluation of the polynomial agrees with the extended Horner scheme
+  const PolyFun p(a);
+  for(size_t N0 = 0; N0 != 7; ++N0){
+    std::vector<double> df(8), dfm(8);
+    p.eval(1.3, 7, df);
+    p.eval(1.3, N0, dfm);
+    p.evalMore(1.3, N0, 7, dfm);
+    for(size_t k = 0; k != 8; ++k){
+      if(fabs(df[k] - dfm[k]) > 1.0e-12*(1.0 + fabs(df[k]))){ return EXIT_FAILURE; }
+    } // End for k
+  } // End for N0
+
+  // The staged evaluation and the solver are well-defined beyond the range of the factorials in double precision, x^200 - 0.5
+  std::vector<double> ah(201, 0.0);
+  ah[0] = -0.5; ah[200] = 1.0;
+  const PolyFun ph(ah);
+  for(size_t N0 = 0; N0 != 3; ++N0){
+    std::vector<double> df(4), dfm(4);
+    ph.eval(0.99, 3, df);
+    ph.eval(0.99, N0, dfm);
+    ph.evalMore(0.99, N0, 3, dfm);
+    for(size_t k = 0; k != 4; ++k){
+      if(!std::isfinite(dfm[k]) || fabs(df[k] - dfm[k]) > 1.0e-12*(1.0 + fabs(df[k]))){ return EXIT_FAILURE; }
+    } // End for k
+  } // End for N0
+  for(size_t strat = 1; strat != 5; ++strat){
+    const HiSolve solver(tol, maxit, 2, false, strat);
+    HiSolveWorkspace ws;
+    const SolveResult r = solver.solve(ph, 0.99, ws);
+    if(!r.converged() || fabs(r.x - pow(0.5, 1.0/200.0)) > 1.0e-12){ return EXIT_FAILURE; }
+  } // End for strat
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    // Both specialized and generic (not specialized) values of Nmax
+    for(const size_t Nmax : {3, 12}){
+      for(int UseMaxOrder = 0; UseMaxOrder != 2; ++UseMaxOrder){
+        HiSolve solver(tol, maxit, Nmax, UseMaxOrder, strat);
+
+        // All solve functions give the same result (up to rounding errors) with and without the staged protocol, but only the function value is evaluated at the solution
+        for(int variant = 0; variant != 3; ++variant){
+          solver.setAdaptiveOrder(variant == 1);
+
+          const Recorded fs(a, true);
+          const Recorded fu(a, false);
+          HiSolveWorkspace ws;
+          const SolveResult rs = variant == 2 ? solver.solveSafeguarded(fs, x0, ws) : solver.solve(fs, x0, ws);
+          const double      xs = rs.x;
+          const SolveResult ru = variant == 2 ? solver.solveSafeguarded(fu, x0, ws) : solver.solve(fu, x0, ws);
+
+          if(!rs.converged() || !ru.converged() || fabs(xs - ru.x) > 1.0e-12){ return EXIT_FAILURE; }
+          if(rs.evaluations != ru.evaluations || fs.orders.size() != rs.evaluations || fu.more != 0){ return EXIT_FAILURE; }
+          if(fs.orders.back() != 0 || fu.orders.back() == 0 || fs.more+1 != rs.evaluations){ return EXIT_FAILURE; }
+          if(rs.df.size() != 1 || rs.df[0] != rs.f){ return EXIT_FAILURE; }
+        } // End for variant
+        solver.setAdaptiveOrder(false);
+
+        // The batched solver gives the same result (up to rounding errors) with and without the staged protocol
+        const size_t n = 37;
+        std::vector<double> x0b(n), xs(n), xu(n);
+        for(size_t i = 0; i != n; ++i){ x0b[i] = -1.5 + 0.2*i; }
+        const Recorded fs(a, true);
+        const Recorded fu(a, false);
+        const size_t ns = solver.solveBatch(fs, n, x0b.data(), xs.data());
+        const size_t nu = solver.solveBatch(fu, n, x0b.data(), xu.data());
+        if(ns != nu || fs.more == 0){ return EXIT_FAILURE; }
+        for(size_t i = 0; i != n; ++i){
+          if(fabs(xs[i] - xu[i]) > 1.0e-12){ return EXIT_FAILURE; }
+        } // End for i
+      } // End for UseMaxOrder
+    } // End for Nmax
+  } // End for strat
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For exp, sqrt, and fabs
+
+// The library being tested
+#include <hi-solve-system.h>
+
+/// The intersection of a circle and a hyperbola, x^2 + y^2 = 4 and x*y = 1
+
+class Circle : public FunSystem<2> {
+  public:
+  void eval(const Vec &x, Vec &F, Mat &J) const override {
+    F = {x[0]*x[0] + x[1]*x[1] - 4.0, x[0]*x[1] - 1.0};
+    J = {2.0*x[0], 2.0*x[1], x[1], x[0]};
+  }
+
+  void evalDirectional(const Vec &x, const size_t k, const Vec &v, Vec &d) const override {
+    if(k == 2){ d = {2.0*(v[0]*v[0] + v[1]*v[1]), 2.0*v[0]*v[1]}; }
+    else      { d = {0.0, 0.0}; }
+  }
+};
+
+/// exp(x_i) + (A*x)_i - b_i (the directional derivatives of order k are exp(x_i)*v_i^k)
+
+class ExpLinear : public FunSystem<3> {
+  public:
+  void eval(const Vec &x, Vec &F, Mat &J) const override {
+    static const double A[9] = {3.0, 1.0, 0.0, 1.0, 4.0, 1.0, 0.0, 1.0, 5.0};
+    for(size_t i = 0; i != 3; ++i){
+      F[i] = exp(x[i]) - 10.0*(i+1);
+      for(size_t j = 0; j != 3; ++j){
+        F[i]      += A[i*3 + j]*x[j];
+        J[i*3 + j] = A[i*3 + j] + (i == j ? exp(x[i]) : 0.0);
+      } // End for j
+    } // End for i
+  }
+
+  void evalDirectional(const Vec &x, const size_t k, const Vec &v, Vec &d) const override {
+    for(size_t i = 0; i != 3; ++i){ d[i] = exp(x[i])*pow(v[i], k); }
+  }
+};
+
+/// A system with a singular Jacobian at the initial guess (only Newton's method, i.e. without overriding evalDirectional)
+
+class Singular : public FunSystem<2> {
+  public:
+  void eval(const Vec &x, Vec &F, Mat &J) const override {
+    F = {x[0] + x[1] - 1.0, 2.0*x[0] + 2.0*x[1] - 3.0};
+    J = {1.0, 1.0, 2.0, 2.0};
+  }
+};
+
+/// Test the solver for small systems of nonlinear algebraic equations
+
+int main(int argc, char **argv){
+  const double tol   = 1.0e-13;
+  const size_t maxit = 50;
+
+  // LU factorization with pivoting
+  FunSystem<3>::Mat A = {0.0, 2.0, 1.0, 1.0, 1.0, 1.0, 2.0, 1.0, 0.0};
+  FunSystem<3>::Vec b = {3.0, 3.0, 3.0};
+  std::array<size_t, 3> p;
+  if(!HiSolveSystem<3>::factorize(A, p)){ return EXIT_FAILURE; }
+  HiSolveSystem<3>::substitute(A, p, b);
+  for(size_t i = 0; i != 3; ++i){
+    if(fabs(b[i] - 1.0) > 1.0e-15){ return EXIT_FAILURE; }
+  } // End for i
+
+  // The solution in the first quadrant with x > y
+  const double xs = sqrt(2.0 + sqrt(3.0));
+  const double ys = 1.0/xs;
+
+  for(const size_t Nmax : {1, 2, 4}){
+    // Iterations used by Newton's method
+    size_t newton[2] = {0, 0};
+
+    for(size_t strat = 1; strat != 4; ++strat){
+      const HiSolveSystem<2> circle(tol, maxit, Nmax, strat);
+      const SystemResult<2> r = circle.solve(Circle(), {3.0, 0.5});
+      if(!r.converged() || fabs(r.x[0] - xs) > 1.0e-12 || fabs(r.x[1] - ys) > 1.0e-12){ return EXIT_FAILURE; }
+      if(r.evaluations != r.iterations + 1){ return EXIT_FAILURE; }
+
+      const HiSolveSystem<3> exps(tol, maxit, Nmax, strat);
+      const SystemResult<3> re = exps.solve(ExpLinear(), {0.0, 0.0, 0.0});
+      if(!re.converged()){ return EXIT_FAILURE; }
+
+      // The high-order corrections reduce the number of LU factorizations (far from the solution, the truncated Taylor expansion in the direction of the Newton-step used by strategy 2 is only accurate for low orders)
+      if(strat == 1){
+        newton[0] = r.iterations;
+        newton[1] = re.iterations;
+        if(r.directional != 0){ return EXIT_FAILURE; }
+      }
+      else if(Nmax > 1 && (r.iterations >= newton[0] || re.directional == 0)){
+        return EXIT_FAILURE;
+      }
+      else if((strat == 3 || Nmax == 2) && Nmax > 1 && re.iterations >= newton[1]){
+        return EXIT_FAILURE;
+      } // End if strat == 1
+    } // End for strat
+  } // End for Nmax
+
+  // Singular Jacobian
+  const HiSolveSystem<2> singular(tol, maxit, 3, 3);
+  if(singular.solve(Singular(), {0.0, 0.0}).status != SolveZeroDerivative){ return EXIT_FAILURE; }
+
+  // Unknown update strategy
+  try{ HiSolveSystem<2>(tol, maxit, 3, 4); return EXIT_FAILURE; } catch(const char*){}
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs and isnan
+#include <sstream> // For std::ostringstream
+#include <string> // For std::string
+
+// The library being tested
+#include <hi-solve.h>
+#include <hi-solve-trace.h>
+#include <poly-fun.h>
+
+/// Kepler's equation, i.e. x - e*sin(x) - M = 0
+
+class Kepler : public Fun {
+  public:
+  Kepler(const double e, const double M) : e_(e), M_(M) {}
+
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    // Derivatives of -e*sin(x), i.e. -e*sin(x), -e*cos(x), e*sin(x), e*cos(x), ...
+    const double s = e_*sin(x), c = e_*cos(x);
+    for(size_t k = 0; k <= N; ++k){
+      df[k] = k%2 == 0 ? (k%4 == 0 ? -s : s) : (k%4 == 1 ? -c : c);
+    } // End for k
+
+    df[0] += x - M_;
+    if(N > 0){ df[1] += 1.0; }
+  }
+
+  private:
+  double e_, M_;
+};
+
+/// Test tracing the iterations of HiSolve
+
+int main(int argc, char **argv){
+  // Tolerance, maximum number of iterations, and initial guess
+  const double tol   = 1.0e-14;
+  const size_t maxit = 50;
+  const double x0    = 4.7;
+
+  // (x - 1)*(x - 2)*(x - 3)*(x - 5)*(x + 1)
+  const PolyFun p({30.0, -31.0, -20.0, 30.0, -10.0, 1.0});
+
+  // The tracing policy which is disabled has no state
+  static_assert(!HiSolveNoTrace::Enabled && HiSolveTrace::Enabled, "Incorrect tracing policies");
+
+  for(size_t strat = 1; strat != 5; ++strat){
+    for(const size_t Nmax : {1, 3, 12}){
+      HiSolve solver(tol, maxit, Nmax, true, strat);
+      HiSolveWorkspace ws;
+      HiSolveTrace trace(64);
+
+      // The traced solve gives the same result as the solve without tracing
+      const double      x = solver.solve(p, x0, ws).x;
+      const SolveResult r = solver.solve(p, x0, ws, trace);
+      if(!r.converged() || r.x != x || trace.size() != r.iterations || trace.dropped() != 0){ return EXIT_FAILURE; }
+
+      // The records are consistent with the iterations
+      double xk = x0;
+      for(size_t i = 0; i != trace.size(); ++i){
+        const HiSolveTraceRecord &rec = trace[i];
+        if(rec.solve != 1 || rec.iteration != i+1 || rec.x != xk || rec.terms != Nmax || rec.order != Nmax){ return EXIT_FAILURE; }
+        if(rec.corrections != Nmax || rec.correction[Nmax-1] != rec.dx){ return EXIT_FAILURE; }
+        if(!(rec.evalTime >= 0.0 && rec.duration >= rec.evalTime && rec.start >= 0.0)){ return EXIT_FAILURE; }
+        xk += rec.dx;
+      } // End for i
+      if(xk != r.x){ return EXIT_FAILURE; }
+
+      // The estimated order of convergence is 2 for Newton-steps (Nmax = 1 or strategy 1) and higher otherwise (strategy 4 with Nmax = 12 converges in too few iterations for an estimate)
+      const bool   Newton = strat == 1 || Nmax == 1;
+      const double pe     = trace.orderOfConvergence();
+      if(strat == 4 && Nmax == 12 && r.iterations < 3){ continue; }
+      if(Newton ? fabs(pe - 2.0) > 0.1 : !(pe > 2.5)){ return EXIT_FAILURE; }
+    } // End for Nmax
+  } // End for strat
+
+  // The traced solve is dispatched like the solve without tracing (i.e. the results are bit-for-bit identical for the specialized engine, the update strategy chosen at run time and the adaptive-order variant)
+  const Kepler kepler(0.9, 1.0);
+  for(size_t strat = 1; strat != 5; ++strat){
+    for(const size_t Nmax : {2, 5, 8, 40}){
+      for(const bool adaptive : {false, true}){
+        HiSolve solver(tol, maxit, Nmax, true, strat);
+        solver.setAdaptiveOrder(adaptive);
+        HiSolveWorkspace ws;
+        for(size_t i = 0; i != 17; ++i){
+          HiSolveTrace trace(64);
+          const double      xi = -4.0 + 0.5*i;
+          const SolveResult s  = solver.solve(kepler, xi, ws);
+          const SolveResult r  = solver.solve(kepler, xi, ws, trace);
+          if(r.status != s.status || r.x != s.x || r.iterations != s.iterations || trace.size() != r.iterations){ return EXIT_FAILURE; }
+        } // End for i
+      } // End for adaptive
+    } // End for Nmax
+  } // End for strat
+
+  // The ring buffer keeps the most recent iterations
+  HiSolve solver(tol, maxit, 1, true, 1);
+  HiSolveWorkspace ws;
+  HiSolveTrace trace(3);
+  const SolveResult r1 = solver.solve(p, 40.0, ws, trace);
+  const SolveResult r2 = solver.solve(p, 6.0, ws, trace);
+  if(trace.size() != 3 || trace.dropped() != r1.iterations + r2.iterations - 3){ return EXIT_FAILURE; }
+  if(trace[2].solve != 2 || trace[2].iteration != r2.iterations || trace[0].iteration != r2.iterations - 2){ return EXIT_FAILURE; }
+
+  // The order of convergence of Newton's method is estimated from the first solve
+  HiSolveTrace newton(64);
+  solver.solve(p, 40.0, ws, newton);
+  if(fabs(newton.orderOfConvergence() - 2.0) > 0.3){ return EXIT_FAILURE; }
+
+  // Export to the Chrome trace event format
+  std::ostringstream out;
+  trace.writeChromeTrace(out);
+  const std::string json = out.str();
+  if(json.find("\"traceEvents\"") == std::string::npos || json.find("\"ph\": \"X\"") == std::string::npos || json.find("\"corrections\": [") == std::string::npos){ return EXIT_FAILURE; }
+
+  trace.clear();
+  if(trace.size() != 0 || !std::isnan(trace.orderOfConvergence())){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cstdio> // For remove
+#include <cmath> // For fabs
+#include <fstream> // For ofstream
+
+// The library being tested
+#include <hi-solve-tuner.h>
+#include <poly-fun.h>
+
+/// Polynomial which counts the number of evaluations
+
+class Counted : public PolyFun {
+  public:
+    mutable size_t count = 0; // Number of evaluations
+
+  Counted(const std::vector<double> &a) : PolyFun(a) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    ++count;
+    PolyFun::eval(x, N, df);
+  }
+
+  bool hasStagedEval() const override { return false; }
+};
+
+/// Test the auto-tuner of HiSolve and the tuning cache
+
+int main(int argc, char **argv){
+  const std::string cache = "ut_hisolve_tuner.cache";
+  std::remove(cache.c_str());
+
+  // A family of cubic polynomials with a single real root (x - r)*(x^2 + 1)
+  std::vector<Counted> funs;
+  for(const double r : {0.5, 1.0, 2.0, 3.5}){ funs.push_back(Counted({-r, 1.0, -r, 1.0})); }
+  std::vector<HiSolveTuner::Problem> problems;
+  for(const Counted &f : funs){
+    for(const double x0 : {-1.0, 2.0, 5.0}){ problems.push_back(HiSolveTuner::Problem(&f, x0)); }
+  } // End for f
+
+  HiSolveTuner tuner(1.0e-10, 50, 3);
+
+  // Invalid arguments
+  try{ tuner.setNmaxCandidates({}); return EXIT_FAILURE; } catch(const char*){}
+  try{ tuner.calibrate({}); return EXIT_FAILURE; } catch(const char*){}
+  try{ HiSolveTuner::save(cache, "two words", HiSolveTuning()); return EXIT_FAILURE; } catch(const char*){}
+  try{ HiSolveTuner::save(cache, "", HiSolveTuning()); return EXIT_FAILURE; } catch(const char*){}
+
+  // The measurements of a configuration
+  HiSolveTuning newton;
+  const HiSolveTuning m = tuner.measure(newton, problems);
+  if(m.Nmax != 1 || m.UpdateStrategy != 1 || !m.UseMaxOrder || m.ns <= 0.0 || m.evaluations < 2.0 || m.failures != 0.0){ return EXIT_FAILURE; }
+
+  // The selected configuration is reliable and solves all problems
+  tuner.setNmaxCandidates({1, 2, 3});
+  const HiSolveTuning best = tuner.calibrate(problems);
+  if(best.failures != 0.0 || best.Nmax < 1 || best.Nmax > 3 || best.UpdateStrategy < 1 || best.UpdateStrategy > 4){ return EXIT_FAILURE; }
+  const HiSolve solver = tuner.solver(best);
+  if(solver.getNmax() != best.Nmax || solver.getUpdateStrategy() != best.UpdateStrategy || solver.getUseMaxOrder() != best.UseMaxOrder){ return EXIT_FAILURE; }
+  HiSolveWorkspace ws;
+  for(const HiSolveTuner::Problem &problem : problems){
+    if(!solver.solve(*problem.first, problem.second, ws).converged()){ return EXIT_FAILURE; }
+  } // End for problem
+
+  // A missing family (or cache) is not loaded
+  HiSolveTuning loaded;
+  if(HiSolveTuner::load(cache, "cubic", loaded)){ return EXIT_FAILURE; }
+
+  // Tuning calibrates and stores the configuration if the family is not in the cache
+  for(const Counted &f : funs){ f.count = 0; }
+  tuner.tune(cache, "cubic", problems);
+  if(funs[0].count == 0 || !HiSolveTuner::load(cache, "cubic", loaded)){ return EXIT_FAILURE; }
+
+  // Saving replaces the entry of the family and keeps the other families
+  HiSolveTuning other;
+  other.Nmax            = 4;
+  other.UpdateStrategy  = 3;
+  other.UseMaxOrder     = false;
+  other.ns              = 123.25;
+  other.evaluations     = 4.5;
+  other.failures        = 0.125;
+  HiSolveTuner::save(cache, "other", other);
+  HiSolveTuner::save(cache, "cubic", other);
+  HiSolveTuner::save(cache, "cubic", best);
+  if(!HiSolveTuner::load(cache, "cubic", loaded) || !HiSolveTuner::load(cache, "other", other)){ return EXIT_FAILURE; }
+  if(loaded.Nmax != best.Nmax || loaded.UpdateStrategy != best.UpdateStrategy || loaded.UseMaxOrder != best.UseMaxOrder){ return EXIT_FAILURE; }
+  if(loaded.ns != best.ns || loaded.evaluations != best.evaluations || loaded.failures != best.failures){ return EXIT_FAILURE; }
+  if(other.Nmax != 4 || other.UpdateStrategy != 3 || other.UseMaxOrder || other.ns != 123.25 || other.evaluations != 4.5 || other.failures != 0.125){ return EXIT_FAILURE; }
+
+  // Tuning does not calibrate if the family is in the cache
+  for(const Counted &f : funs){ f.count = 0; }
+  const HiSolve tuned = tuner.tune(cache, "cubic", problems);
+  for(const Counted &f : funs){
+    if(f.count != 0){ return EXIT_FAILURE; }
+  } // End for f
+  if(tuned.getNmax() != best.Nmax || tuned.getUpdateStrategy() != best.UpdateStrategy || tuned.getUseMaxOrder() != best.UseMaxOrder){ return EXIT_FAILURE; }
+
+  // A corrupt entry is reported
+  {
+    std::ofstream file(cache, std::ios::trunc);
+    file << "# hi-solve tuning cache 1\ncubic 0 1 1 1 1 0\n";
+  }
+  try{ HiSolveTuner::load(cache, "cubic", loaded); return EXIT_FAILURE; } catch(const char*){}
+
+  std::remove(cache.c_str());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs, exp, sin, and cos
+
+// The library being tested
+#include <hi-solve.h>
+#include <poly-fun.h>
+
+/// The Mobius transformation (x - a)/(x - b), which equals its own [1/1] Pade approximant
+
+class Mobius : public Fun {
+  public:
+    double a, b;
+
+  Mobius(const double a, const double b) : a(a), b(b) {}
+
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    // f = 1 + (b - a)/(x - b), whose k'th order derivative is (b - a)*(-1)^k*k!/(x - b)^(k+1)
+    double c = (b - a)/(x - b);
+    df[0] = 1.0 + c;
+    for(size_t k = 1; k <= N; ++k){
+      c *= -double(k)/(x - b);
+      df[k] = c;
+    } // End for k
+  }
+};
+
+/// exp(x) - 2
+
+class Exp : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    df[0] = exp(x) - 2.0;
+    for(size_t k = 1; k <= N; ++k){ df[k] = exp(x); }
+  }
+};
+
+/// Kepler's equation E - 0.9*sin(E) - 1
+
+class Kepler : public Fun {
+  public:
+  void eval(const double x, const size_t N, DfSpan df) const override {
+    const double s = sin(x), c = cos(x);
+    const double d[4] = {-0.9*s, -0.9*c, 0.9*s, 0.9*c};
+    df[0] = x - 0.9*s - 1.0;
+    if(N > 0){ df[1] = 1.0 - 0.9*c; }
+    for(size_t k = 2; k <= N; ++k){ df[k] = d[k%4]; }
+  }
+};
+
+/// Test update strategy 4 (the root of a Pade approximant) in HiSolve
+
+int main(int argc, char **argv){
+  const double tol   = 1.0e-13;
+  const size_t maxit = 50;
+
+  // Strategy 4 is valid (and an unknown strategy is not)
+  HiSolve solver(tol, maxit, 3, true, 4);
+  if(solver.getUpdateStrategy() != 4){ return EXIT_FAILURE; }
+  try{ solver.setUpdateStrategy(5); return EXIT_FAILURE; } catch(const char*){}
+
+  // The updates for one and two terms are the Newton-step and the Halley-step
+  const std::vector<double> df = {0.3, -1.7, 2.9, -0.4, 5.0};
+  if(hiSolveUpdate(4, df, 1) != -df[0]/df[1]){ return EXIT_FAILURE; }
+  const double halley = -2.0*df[0]*df[1]/(2.0*df[1]*df[1] - df[0]*df[2]);
+  if(fabs(hiSolveUpdate(4, df, 2) - halley) > 1.0e-15*fabs(halley)){ return EXIT_FAILURE; }
+
+  // The update is exact for a Mobius transformation when using at least two terms (for any variant and value of Nmax)
+  const Mobius m(0.5, 3.0);
+  for(const size_t Nmax : {2, 3, 5, 12, 20}){
+    for(int UseMaxOrder = 0; UseMaxOrder != 2; ++UseMaxOrder){
+      const HiSolve exact(tol, maxit, Nmax, UseMaxOrder, 4);
+      HiSolveWorkspace ws;
+      const SolveResult r = exact.solve(m, 2.0, ws);
+      if(!r.converged() || fabs(r.x - 0.5) > 1.0e-12 || r.iterations > (UseMaxOrder ? 1 : 2)){ return EXIT_FAILURE; }
+    } // End for UseMaxOrder
+  } // End for Nmax
+
+  // At equal Nmax, strategy 4 needs no more iterations than strategies 1-3 on a small corpus
+  const PolyFun p({30.0, -31.0, -20.0, 30.0, -10.0, 1.0});
+  const Exp e;
+  const Kepler k;
+  const std::vector<std::pair<const Fun*, double> > corpus = {{&p, 4.7}, {&p, -3.0}, {&e, 3.0}, {&e, -1.0}, {&k, 0.0}, {&k, 3.0}};
+  for(const size_t Nmax : {2, 3, 4, 6}){
+    size_t iterations[5] = {0, 0, 0, 0, 0};
+    for(size_t strat = 1; strat != 5; ++strat){
+      const HiSolve s(tol, maxit, Nmax, true, strat);
+      HiSolveWorkspace ws;
+      for(const auto &problem : corpus){
+        const SolveResult r = s.solve(*problem.first, problem.second, ws);
+        if(!r.converged()){ return EXIT_FAILURE; }
+        iterations[strat] += r.iterations;
+      } // End for problem
+    } // End for strat
+    if(iterations[4] > iterations[1] || iterations[4] > iterations[2] || iterations[4] > iterations[3]){ return EXIT_FAILURE; }
+  } // End for Nmax
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For pow and fabs
+
+// The library being tested
+#include <hi-solve.h>
+#include <poly-fun.h>
+
+/// Evaluate the k'th order derivative of a polynomial term by term
+
+double derivative(const std::vector<double> &a, const double x, const size_t k){
+  double d = 0.0;
+  for(size_t i = k; i < a.size(); ++i){
+    // Falling factorial, i*(i-1)*...*(i-k+1)
+    double fac = 1.0;
+    for(size_t l = 0; l != k; ++l){
+      fac *= i - l;
+    } // End for l
+
+    d += fac*a[i]*pow(x, i-k);
+  } // End for i
+  return d;
+}
+
+/// Test the polynomial function object
+
+int main(int argc, char **argv){
+  // Coefficients of (x - 1)*(x - 2)*(x - 3)*(x + 0.5)*(x^2 + 1)
+  const std::vector<double> a = { -3.0, -0.5, 5.0, -6.0, 9.0, -5.5, 1.0 };
+  const PolyFun p(a);
+  const size_t  m = p.getDegree();
+
+  // Highest order (beyond the degree, such that vanishing derivatives are also checked)
+  const size_t N = m + 2;
+
+  // Evaluation points
+  const std::vector<double> x = { -1.3, -0.5, 0.0, 0.25, 1.0, 2.7, 3.1 };
+  const size_t n = x.size();
+
+  // Scalar evaluation
+  std::vector<double> df(N+1);
+  for(size_t j = 0; j != n; ++j){
+    p.eval(x[j], N, df);
+    for(size_t k = 0; k != N+1; ++k){
+      if(fabs(df[k] - derivative(a, x[j], k)) > 1.0e-10*(1.0 + fabs(df[k]))){ return EXIT_FAILURE; }
+    } // End for k
+  } // End for j
+
+  // Batched evaluation of one polynomial and of n copies of the polynomial
+  std::vector<double> dfSoA((N+1)*n), dfMany((N+1)*n), aSoA((m+1)*n);
+  for(size_t i = 0; i != m+1; ++i){
+    for(size_t j = 0; j != n; ++j){
+      aSoA[i*n + j] = a[i];
+    } // End for j
+  } // End for i
+
+  p.evalBatch(x.data(), n, N, dfSoA.data());
+  PolyFun::evalMany(m, n, aSoA.data(), x.data(), N, dfMany.data());
+  for(size_t j = 0; j != n; ++j){
+    p.eval(x[j], N, df);
+    for(size_t k = 0; k != N+1; ++k){
+      if(dfSoA [k*n + j] != df[k]){ return EXIT_FAILURE; }
+      if(dfMany[k*n + j] != df[k]){ return EXIT_FAILURE; }
+    } // End for k
+  } // End for j
+
+  // Find the roots close to 2 and 3
+  HiSolve solver(1.0e-12, 20, 4, true, 3);
+  if(fabs(solver.solve(p, 2.2) - 2.0) > 1.0e-10){ return EXIT_FAILURE; }
+  if(fabs(solver.solve(p, 3.3) - 3.0) > 1.0e-10){ return EXIT_FAILURE; }
+
+  // A polynomial without coefficients is invalid
+  bool ConstructorFailsWithoutCoefficients = false;
+  try{
+    PolyFun q(std::vector<double>(0));
+  } catch(const char* msg) {
+    ConstructorFailsWithoutCoefficients = true;
+  }
+
+  if(!ConstructorFailsWithoutCoefficients){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}
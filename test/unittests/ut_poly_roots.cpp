@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For fabs and pow
+
+// The library being tested
+#include <poly-roots.h>
+
+/// Coefficients (in ascending order) of the monic polynomial with the given roots
+
+std::vector<double> fromRoots(const std::vector<double> &roots){
+  std::vector<double> a(1, 1.0);
+  for(const double r : roots){
+    a.push_back(0.0);
+    for(size_t i = a.size()-1; i != 0; --i){ a[i] = a[i-1] - r*a[i]; }
+    a[0] *= -r;
+  } // End for r
+  return a;
+}
+
+/// Check that the real roots and multiplicities are as expected
+
+bool check(const std::vector<PolyRoot> &r, const std::vector<double> &x, const std::vector<size_t> &mult, const double tol){
+  if(r.size() != x.size()){ return false; }
+  for(size_t i = 0; i != x.size(); ++i){
+    if(fabs(r[i].x - x[i]) > tol || r[i].multiplicity != mult[i]){ return false; }
+  } // End for i
+  return true;
+}
+
+/// Test the all-roots polynomial solver
+
+int main(int argc, char **argv){
+  for(size_t strat = 1; strat != 5; ++strat){
+    const HiSolve   solver(1.0e-12, 50, 3, true, strat);
+    const PolyRoots engine(solver);
+
+    // Distinct real roots (Wilkinson's polynomial of degree 8)
+    const PolyFun w(fromRoots({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0}));
+    if(engine.roots(w).size() != 8){ return EXIT_FAILURE; }
+    if(!check(engine.realRoots(w, 0.0, 10.0), {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0}, {1, 1, 1, 1, 1, 1, 1, 1}, 1.0e-10)){ return EXIT_FAILURE; }
+
+    // Only the roots in the interval are returned (and the ends of the interval may be given in any order)
+    if(!check(engine.realRoots(w, 5.5, 2.5), {3.0, 4.0, 5.0}, {1, 1, 1}, 1.0e-10)){ return EXIT_FAILURE; }
+
+    // A triple root, a simple root, and a pair of complex roots, (x - 1)^3*(x + 2)*(x^2 + 1)
+    std::vector<double> a = fromRoots({1.0, 1.0, 1.0, -2.0});
+    std::vector<double> b(a.size() + 2, 0.0);
+    for(size_t i = 0; i != a.size(); ++i){
+      b[i]   += a[i];
+      b[i+2] += a[i];
+    } // End for i
+    const PolyFun q(b);
+    if(engine.roots(q).size() != 6){ return EXIT_FAILURE; }
+    if(!check(engine.realRoots(q, -5.0, 5.0), {-2.0, 1.0}, {1, 3}, 1.0e-10)){ return EXIT_FAILURE; }
+
+    // Roots at zero, x^2*(x - 3), and leading zero coefficients
+    const PolyFun z({0.0, 0.0, -3.0, 1.0, 0.0});
+    if(engine.roots(z).size() != 3){ return EXIT_FAILURE; }
+    if(!check(engine.realRoots(z, -1.0, 4.0), {0.0, 3.0}, {2, 1}, 1.0e-12)){ return EXIT_FAILURE; }
+
+    // Close but distinct roots are not merged
+    const PolyFun c(fromRoots({1.0, 1.001, -0.5}));
+    if(!check(engine.realRoots(c, -1.0, 2.0), {-0.5, 1.0, 1.001}, {1, 1, 1}, 1.0e-10)){ return EXIT_FAILURE; }
+
+    // High degree, beyond the range of the factorials in double precision, x^200 - 0.5
+    std::vector<double> h(201, 0.0);
+    h[0] = -0.5; h[200] = 1.0;
+    const double rh = pow(0.5, 1.0/200.0);
+    if(!check(engine.realRoots(PolyFun(h), -2.0, 2.0), {-rh, rh}, {1, 1}, 1.0e-12)){ return EXIT_FAILURE; }
+
+    // A double root which is polished using the derivative of a polynomial of high degree, (x - 0.5)^2*(x^170 + 1)
+    const std::vector<double> d = fromRoots({0.5, 0.5});
+    std::vector<double> e(173, 0.0);
+    for(size_t i = 0; i != d.size(); ++i){
+      e[i]     += d[i];
+      e[i+170] += d[i];
+    } // End for i
+    if(!check(engine.realRoots(PolyFun(e), 0.0, 0.9), {0.5}, {2}, 1.0e-12)){ return EXIT_FAILURE; }
+
+    // No real roots, x^2 + 1, and a constant
+    if(!engine.realRoots(PolyFun({1.0, 0.0, 1.0}), -10.0, 10.0).empty()){ return EXIT_FAILURE; }
+    if(!engine.roots(PolyFun({2.0})).empty()){ return EXIT_FAILURE; }
+  } // End for strat
+
+  return EXIT_SUCCESS;
+}
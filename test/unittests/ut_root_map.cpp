@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cstdio> // For remove
+#include <cmath> // For fabs, sqrt, sin, and cos
+
+// The library being tested
+#include <root-map.h>
+
+/// Kepler's equation E - e*sin(E) - M = 0 with the mean anomaly M as the parameter
+
+class Kepler : public ParamFun {
+  public:
+    double e; // Eccentricity
+
+  Kepler(const double e) : e(e) {}
+
+  void eval(const double x, const double p, const size_t N, DfSpan df) const override {
+    const double s = sin(x), c = cos(x);
+    const double d[4] = {-e*s, -e*c, e*s, e*c};
+    df[0] = x - e*s - p;
+    if(N > 0){ df[1] = 1.0 - e*c; }
+    for(size_t k = 2; k <= N; ++k){ df[k] = d[k%4]; }
+  }
+
+  double evalParam(const double x, const double p) const override { return -1.0; }
+};
+
+/// x^2 - p, whose positive root sqrt(p) turns back at p = 0
+
+class Fold : public ParamFun {
+  public:
+  void eval(const double x, const double p, const size_t N, DfSpan df) const override {
+    df[0] = x*x - p;
+    if(N > 0){ df[1] = 2.0*x; }
+    if(N > 1){ df[2] = 2.0; }
+    for(size_t k = 3; k <= N; ++k){ df[k] = 0.0; }
+  }
+
+  double evalParam(const double x, const double p) const override { return -1.0; }
+};
+
+/// Test the precomputed approximant of the root map
+
+int main(int argc, char **argv){
+  const std::string path = "ut_root_map.bin";
+  const HiSolve solver(1.0e-14, 50, 3, true, 3);
+  const double pi = 3.14159265358979323846;
+
+  // Invalid arguments
+  const Kepler f(0.7);
+  try{ RootMap::build(path, f, solver, 0.0, 1.0, 1.0, 1.0e-8); return EXIT_FAILURE; } catch(const char*){}
+  try{ RootMap::build(path, f, solver, 0.0, 0.0, 1.0, 0.0); return EXIT_FAILURE; } catch(const char*){}
+  try{ RootMap::build(path, f, solver, 0.0, 0.0, 2.0*pi, 1.0e-12, 20); return EXIT_FAILURE; } catch(const char*){}
+
+  // The root map cannot be sampled across the turning point
+  try{ RootMap::build(path, Fold(), solver, 2.0, -1.0, 4.0, 1.0e-8); return EXIT_FAILURE; } catch(const char*){}
+
+  // The approximant reaches the requested accuracy with few segments
+  for(const double tol : {1.0e-6, 1.0e-10}){
+    const size_t n = RootMap::build(path, f, solver, 0.0, 0.0, 2.0*pi, tol);
+    const RootMap map(path);
+    if(map.getSegments() != n || n > 2000 || map.getTable().getDegree() != 3){ return EXIT_FAILURE; }
+
+    HiSolveWorkspace ws;
+    for(size_t j = 0; j <= 1000; ++j){
+      const double p = 2.0*pi*j/1000;
+      const SolveResult r = solver.solve(FixedParamFun(f, p), p, ws);
+      if(!r.converged() || fabs(map(p) - r.x) > 10.0*tol){ return EXIT_FAILURE; }
+
+      // The derivative of the approximant approximates the tangent
+      std::vector<double> df(2);
+      map.getTable().eval(p, 1, df);
+      if(fabs(df[1] - 1.0/(1.0 - f.e*cos(r.x))) > 1.0e3*sqrt(tol)){ return EXIT_FAILURE; }
+
+      // A single high-order step gives the root to full accuracy
+      if(fabs(map.polish(f, p) - r.x) > 1.0e-13 || fabs(map.polish(f, p, 1, 1) - r.x) > 1.0e2*tol*tol + 1.0e-13){ return EXIT_FAILURE; }
+    } // End for j
+  } // End for tol
+
+  const RootMap map(path);
+  try{ map.polish(f, 1.0, 0); return EXIT_FAILURE; } catch(const char*){}
+  try{ map.polish(f, 1.0, 2, 5); return EXIT_FAILURE; } catch(const char*){}
+
+  std::remove(path.c_str());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cstdio> // For remove
+#include <cmath> // For sin, cos, asin, and fabs
+#include <vector> // For std::vector
+
+// The library being tested
+#include <hi-solve.h>
+#include <table-fun.h>
+
+/// Test the memory-mapped tabulated function object
+
+int main(int argc, char **argv){
+  const char *path = "ut_table_fun.tab";
+
+  // Piecewise polynomial on a nonuniform grid: x^3 on [0, 1) and 1 + 3*(x - 1) - (x - 1)^2 on [1, 3)
+  TableFun::write(path, 3, {0.0, 1.0, 3.0}, {0.0, 0.0, 0.0, 1.0, 1.0, 3.0, -1.0, 0.0});
+  {
+    const TableFun f(path);
+    if(f.isUniform() || f.getDegree() != 3 || f.getSegments() != 2){ return EXIT_FAILURE; }
+    if(f.segment(-1.0) != 0 || f.segment(0.5) != 0 || f.segment(1.0) != 1 || f.segment(5.0) != 1){ return EXIT_FAILURE; }
+
+    // The derivatives are exact (and zero above the degree)
+    std::vector<double> df(6);
+    f.eval(0.5, 5, df);
+    if(df[0] != 0.125 || df[1] != 0.75 || df[2] != 3.0 || df[3] != 6.0 || df[4] != 0.0 || df[5] != 0.0){ return EXIT_FAILURE; }
+    f.eval(2.0, 2, df);
+    if(df[0] != 3.0 || df[1] != 1.0 || df[2] != -2.0){ return EXIT_FAILURE; }
+  }
+
+  // Interpolant of sin(x) on a uniform grid
+  const size_t  n = 1000;
+  const double  h = 8.0/n;
+  std::vector<double> y(n+1);
+  for(size_t j = 0; j != n+1; ++j){ y[j] = sin(-1.0 + j*h); }
+
+  for(const size_t m : {1, 2, 5}){
+    TableFun::writeInterpolant(path, m, -1.0, h, y);
+    const TableFun f(path);
+    if(!f.isUniform() || f.getDegree() != m || f.getSegments() != n){ return EXIT_FAILURE; }
+
+    // The data is interpolated and the derivatives converge
+    std::vector<double> df(m+2);
+    for(size_t j = 0; j < n; j += 7){
+      f.eval(-1.0 + j*h, m+1, df);
+      if(fabs(df[0] - y[j]) > 1.0e-14 || df[m+1] != 0.0){ return EXIT_FAILURE; }
+      f.eval(-1.0 + (j + 0.3)*h, 1, df);
+      if(fabs(df[1] - cos(-1.0 + (j + 0.3)*h)) > (m == 1 ? 1.0e-2 : 1.0e-4)){ return EXIT_FAILURE; }
+    } // End for j
+
+    // Solve sin(x) = 1/2 using the tabulated function (the accuracy is limited by the interpolation error)
+    const double y0 = 0.5;
+    TableFun::write(path, 0, 0.0, 1.0, {0.0}); // The mapping of the interpolant is not affected by replacing the file
+    for(size_t strat = 1; strat != 4; ++strat){
+      const HiSolve solver(1.0e-13, 50, m, true, strat);
+      HiSolveWorkspace ws;
+      struct Shifted : public Fun {
+        const Fun &f;
+        Shifted(const Fun &f) : f(f) {}
+        void eval(const double x, const size_t N, DfSpan df) const override { f.eval(x, N, df); df[0] -= 0.5; }
+      } g(f);
+      const SolveResult r = solver.solve(g, 0.2, ws);
+      if(!r.converged() || fabs(r.x - asin(y0)) > (m == 5 ? 1.0e-12 : 1.0e-5)){ return EXIT_FAILURE; }
+    } // End for strat
+  } // End for m
+
+  // Linear data is interpolated exactly by the pieces of degree 1 (and degree 0 is not valid)
+  TableFun::writeInterpolant(path, 1, 0.0, 1.0, {1.0, 2.0, 3.0, 4.0});
+  {
+    const TableFun f(path);
+    std::vector<double> df(2);
+    for(const double x : {0.5, 1.5, 2.5}){
+      f.eval(x, 1, df);
+      if(df[0] != x + 1.0 || df[1] != 1.0){ return EXIT_FAILURE; }
+    } // End for x
+  }
+  try{ TableFun::writeInterpolant(path, 0, 0.0, 1.0, {1.0, 2.0, 3.0, 4.0}); return EXIT_FAILURE; } catch(const char*){}
+
+  // Invalid tables
+  try{ TableFun::write(path, 2, {0.0, 1.0}, {1.0, 2.0}); return EXIT_FAILURE; } catch(const char*){}
+  try{ TableFun::writeInterpolant(path, 3, 0.0, 1.0, {1.0, 2.0}); return EXIT_FAILURE; } catch(const char*){}
+  {
+    FILE *file = fopen(path, "wb");
+    fputs("HSTABLE1 is not followed by a header", file);
+    fclose(file);
+  }
+  try{ TableFun f(path); return EXIT_FAILURE; } catch(const char*){}
+  try{ TableFun f("no-such-table.tab"); return EXIT_FAILURE; } catch(const char*){}
+
+  std::remove(path);
+  return EXIT_SUCCESS;
+}
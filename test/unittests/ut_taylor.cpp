@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2019 Tobias Kasper Skovborg Ritschel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard libraries
+#include <cstdlib> // For EXIT_SUCCESS and EXIT_FAILURE
+#include <cmath> // For exp, log, sin, cos, pow, sqrt, and fabs
+
+// The library being tested
+#include <hi-solve.h>
+#include <taylor.h>
+
+/// Check whether two numbers are equal to within a relative tolerance
+
+bool close(const double a, const double b){
+  return fabs(a - b) <= 1.0e-12*(1.0 + fabs(b));
+}
+
+/// Test the truncated Taylor series arithmetic and the TaylorFun adapter
+
+int main(int argc, char **argv){
+  // Highest order and point to expand around
+  const size_t N = 6;
+  typedef Taylor<double, N> T;
+  const double x0 = 0.7;
+  const T x = T::variable(x0);
+
+  // Derivatives of exp(2*x) are 2^k*exp(2*x)
+  const T e = exp(2.0*x);
+  for(size_t k = 0; k != N+1; ++k){
+    if(!close(e.derivative(k), pow(2.0, k)*exp(2.0*x0))){ return EXIT_FAILURE; }
+  } // End for k
+
+  // Derivatives of sin(x) cycle through sin, cos, -sin, and -cos
+  const T s = sin(x);
+  const double ds[] = { sin(x0), cos(x0), -sin(x0), -cos(x0) };
+  for(size_t k = 0; k != N+1; ++k){
+    if(!close(s.derivative(k), ds[k%4])){ return EXIT_FAILURE; }
+  } // End for k
+
+  // Identities which must hold for all coefficients
+  const T a = 1.5 + x*x - 0.3*x;
+  const T one   = sin(a)*sin(a) + cos(a)*cos(a);
+  const T ident = exp(log(a));
+  const T root  = sqrt(a)*sqrt(a);
+  const T quot  = (a*x)/x;
+  const T pw    = pow(a, 2.5);
+  const T pe    = exp(2.5*log(a));
+  const T p3    = pow(x - 1.0, 3);
+  const T c3    = (x - 1.0)*(x - 1.0)*(x - 1.0);
+  const T pt    = pow(a, x);
+  const T ptr   = exp(x*log(a));
+  for(size_t k = 0; k != N+1; ++k){
+    if(!close(one[k], k == 0 ? 1.0 : 0.0)){ return EXIT_FAILURE; }
+    if(!close(ident[k], a[k])){ return EXIT_FAILURE; }
+    if(!close(root [k], a[k])){ return EXIT_FAILURE; }
+    if(!close(quot [k], a[k])){ return EXIT_FAILURE; }
+    if(!close(pw   [k], pe[k])){ return EXIT_FAILURE; }
+    if(!close(p3   [k], c3[k])){ return EXIT_FAILURE; }
+    if(!close(pt   [k], ptr[k])){ return EXIT_FAILURE; }
+  } // End for k
+
+  // Solve x*exp(x) = 1 (the solution is the omega constant) with derivatives computed automatically
+  const size_t Nmax  = 4;
+  const double tol   = 1.0e-14;
+  const double omega = 0.56714329040978387300;
+  const auto f = makeTaylorFun<Nmax+1>([](const auto &x){ return x*exp(x) - 1.0; });
+
+  for(size_t strat = 1; strat != 4; ++strat){
+    HiSolve solver(tol, 20, Nmax, true, strat);
+    if(fabs(solver.solve(f, 1.0) - omega) > 1.0e-12){ return EXIT_FAILURE; }
+  } // End for strat
+
+  // Requesting too many derivatives must fail
+  bool EvalFailsWithTooHighOrder = false;
+  std::vector<double> df(Nmax+3);
+  try{
+    f.eval(1.0, Nmax+2, df);
+  } catch(const char* msg) {
+    EvalFailsWithTooHighOrder = true;
+  }
+
+  if(!EvalFailsWithTooHighOrder){ return EXIT_FAILURE; }
+
+  return EXIT_SUCCESS;
+}